@@ -1,19 +1,247 @@
+#include <algorithm>
 #include <chrono>
 #include <print>
+#include <random>
 #include <ratio>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "automatic_shortest_path_finder.hpp"
 #include "breadth_first_search.hpp"
 #include "breadth_first_search_parallel.hpp"
+#include "cached_shortest_path_finder.hpp"
+#include "cost_model.hpp"
 #include "floyd_warshall.hpp"
 #include "floyd_warshall_parallel.hpp"
 #include "graph.hpp"
 #include "graph_factory.hpp"
+#include "partitioned_breadth_first_search.hpp"
+#include "query_executor.hpp"
+#include "result_cache.hpp"
 
 using namespace NShortestPaths;
 
+// The TCompletionRecorder class wraps a finder and records the moment every
+// query finishes, indexed by its starting vertex.
+class TCompletionRecorder : public IShortestPathFinder {
+   public:
+    TCompletionRecorder(
+        const IShortestPathFinder& finder,
+        std::vector<std::chrono::steady_clock::time_point>& completions)
+        : Finder_(finder), Completions_(completions) {}
+
+   protected:
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override {
+        auto result = Finder_.Compute(graph, start, token);
+        Completions_[start] = std::chrono::steady_clock::now();
+        return result;
+    }
+
+   private:
+    const IShortestPathFinder& Finder_;
+    std::vector<std::chrono::steady_clock::time_point>& Completions_;
+};
+
+// Measures the latency of point queries submitted behind all-pairs jobs.
+void BenchmarkMixedLoad() {
+    constexpr int pointVertices = 20000;
+    constexpr int bulkVertices = 300;
+    constexpr int pointQueries = 100;
+    constexpr int bulkQueries = 4;
+
+    auto makeGraph = [](int n) {
+        std::istringstream iss(
+            NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n)));
+        TGraph graph;
+        graph.Load(iss);
+        return graph;
+    };
+    TGraph pointGraph = makeGraph(pointVertices);
+    TGraph bulkGraph = makeGraph(bulkVertices);
+
+    TBreadthFirstSearch bfs;
+    TFloydWarshall floyd;
+    std::vector<std::chrono::steady_clock::time_point> completions(
+        pointQueries);
+    TCompletionRecorder recorder(bfs, completions);
+    unsigned int numThreads =
+        std::max(2u, std::thread::hardware_concurrency());
+
+    std::print(stdout,
+               "\nMixed load: {} point BFS queries (n={}) behind {} Floyd "
+               "jobs (n={}), {} workers.\n",
+               pointQueries, pointVertices, bulkQueries, bulkVertices,
+               numThreads);
+    std::print(stdout, "{:>16} {:>12} {:>12} {:>12}\n", "Lanes", "p50_ms",
+               "p99_ms", "max_ms");
+
+    for (bool lanes : {false, true}) {
+        TQueryExecutor executor(numThreads);
+        std::vector<TQueryHandle> handles;
+        // Submit the all-pairs jobs first so that point queries queue behind
+        // them.
+        for (int i = 0; i < bulkQueries; ++i) {
+            handles.push_back(executor.Submit(
+                floyd, bulkGraph, 0,
+                {lanes ? EQueryPriority::Bulk : EQueryPriority::Point}));
+        }
+        auto submitTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < pointQueries; ++i) {
+            handles.push_back(executor.Submit(recorder, pointGraph, i));
+        }
+        for (auto& handle : handles) {
+            handle.Result().get();
+        }
+
+        // Latencies are measured from the submission of the point queries.
+        std::vector<double> latencies;
+        for (const auto& completion : completions) {
+            latencies.push_back(std::chrono::duration<double, std::milli>(
+                                    completion - submitTime)
+                                    .count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::print(stdout, "{:>16} {:12.3f} {:12.3f} {:12.3f}\n",
+                   lanes ? "priority" : "single", latencies[pointQueries / 2],
+                   latencies[pointQueries * 99 / 100], latencies.back());
+    }
+}
+
+// Measures repeated queries from a small set of hot sources with and without
+// the result cache.
+void BenchmarkHotSources() {
+    constexpr int n = 50000;
+    constexpr int hotSources = 16;
+    constexpr int queries = 200;
+    constexpr std::size_t budgetBytes = 4 << 20;
+
+    std::istringstream iss(
+        NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n)));
+    TGraph graph;
+    graph.Load(iss);
+
+    // Use fixed seed for reproducibility.
+    std::mt19937 g(42);
+    std::uniform_int_distribution<int> pick(0, hotSources - 1);
+    std::vector<int> sources(queries);
+    for (auto& source : sources) {
+        source = pick(g) * (n / hotSources);
+    }
+
+    TBreadthFirstSearch bfs;
+    TResultCache cache(budgetBytes);
+    TCachedShortestPathFinder cached(bfs, "bfs-seq", cache);
+
+    auto run = [&](const IShortestPathFinder& finder) {
+        auto startTime = std::chrono::steady_clock::now();
+        for (auto source : sources) {
+            auto distances = finder.Compute(graph, source);
+        }
+        auto endTime = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(endTime - startTime)
+            .count();
+    };
+    double uncachedMs = run(bfs);
+    double cachedMs = run(cached);
+    auto stats = cache.Statistics();
+
+    std::print(stdout,
+               "\nHot sources: {} BFS queries from {} sources (n={}), "
+               "budget {} KiB.\n",
+               queries, hotSources, n, budgetBytes / 1024);
+    std::print(stdout, "{:>12} {:>12} {:>10} {:>10} {:>12} {:>12}\n",
+               "Plain_ms", "Cached_ms", "Hit_rate", "Entries", "Cache_KiB",
+               "Plain_KiB");
+    std::print(stdout, "{:12.3f} {:12.3f} {:10.3f} {:10} {:12} {:12}\n",
+               uncachedMs, cachedMs, stats.HitRate(), stats.Entries,
+               stats.Bytes / 1024, stats.Entries * n * sizeof(int) / 1024);
+}
+
+// Measures the partitioned BFS and its communication volume per level.
+void BenchmarkPartitioned() {
+    constexpr int n = 100000;
+    int parts = static_cast<int>(
+        std::max(2u, std::thread::hardware_concurrency()));
+
+    std::istringstream iss(
+        NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n)));
+    TGraph graph;
+    graph.Load(iss);
+
+    TBreadthFirstSearch bfs;
+    TPartitionedBreadthFirstSearch partitioned(parts);
+    auto measure = [](auto&& func) {
+        auto startTime = std::chrono::steady_clock::now();
+        func();
+        auto endTime = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(endTime - startTime)
+            .count();
+    };
+    std::vector<int> expected;
+    TPartitionedBfsResult result;
+    double bfsMs = measure([&] { expected = bfs.Compute(graph, 0); });
+    double partMs =
+        measure([&] { result = partitioned.ComputeWithStats(graph, 0); });
+    if (result.Distances != expected) {
+        std::print(stderr, "Partitioned BFS mismatch\n");
+        return;
+    }
+
+    std::print(stdout,
+               "\nPartitioned BFS: n={}, {} processes, BFS_seq {:.3f} ms, "
+               "BFS_part {:.3f} ms.\n",
+               n, parts, bfsMs, partMs);
+    std::print(stdout, "{:>6} {:>10} {:>10} {:>10} {:>10}\n", "Level",
+               "Frontier", "Messages", "Batches", "Bytes");
+    for (size_t i = 0; i < result.Levels.size(); ++i) {
+        const auto& level = result.Levels[i];
+        std::print(stdout, "{:6} {:10} {:10} {:10} {:10}\n", i, level.Frontier,
+                   level.Messages, level.Batches, level.Bytes);
+    }
+}
+
+// Measures the cost of recording predecessors during BFS.
+void BenchmarkPredecessors() {
+    constexpr int n = 200000;
+    constexpr int iterations = 3;
+
+    std::istringstream iss(
+        NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n)));
+    TGraph graph;
+    graph.Load(iss);
+
+    auto measure = [](auto&& func) {
+        double total = 0.0;
+        for (int i = 0; i < iterations; ++i) {
+            auto startTime = std::chrono::steady_clock::now();
+            func();
+            auto endTime = std::chrono::steady_clock::now();
+            total +=
+                std::chrono::duration<double, std::milli>(endTime - startTime)
+                    .count();
+        }
+        return total / iterations;
+    };
+
+    TBreadthFirstSearch bfsSeq;
+    TBreadthFirstSearchParallel bfsPar;
+    double seqMs = measure([&] { (void)bfsSeq.Compute(graph, 0); });
+    double seqTreeMs = measure([&] { (void)bfsSeq.ComputeTree(graph, 0); });
+    double parMs = measure([&] { (void)bfsPar.Compute(graph, 0); });
+    double parTreeMs = measure([&] { (void)bfsPar.ComputeTree(graph, 0); });
+
+    std::print(stdout, "\nPredecessor tracking: n={}.\n", n);
+    std::print(stdout, "{:>10} {:>12} {:>12} {:>10}\n", "Algorithm",
+               "Distances", "With_tree", "Overhead");
+    std::print(stdout, "{:>10} {:12.3f} {:12.3f} {:9.1f}%\n", "BFS_seq",
+               seqMs, seqTreeMs, (seqTreeMs / seqMs - 1.0) * 100.0);
+    std::print(stdout, "{:>10} {:12.3f} {:12.3f} {:9.1f}%\n", "BFS_par",
+               parMs, parTreeMs, (parTreeMs / parMs - 1.0) * 100.0);
+}
+
 int main() {
     // Print introductory information for the benchmark.
     std::print(stdout, "Benchmarking Algorithms (Sequential and Parallel).\n");
@@ -21,12 +249,14 @@ int main() {
     std::print(stdout, "Iterations per test: 3.\n");
     std::print(
         stdout,
-        "---------------------------------------------------------------\n");
-    std::print(stdout, "{:>6} {:>12} {:>12} {:>12} {:>12}\n", "Size", "BFS_seq",
-               "BFS_par", "Floyd_seq", "Floyd_par");
+        "----------------------------------------------------------------------"
+        "------\n");
+    std::print(stdout, "{:>6} {:>12} {:>12} {:>12} {:>12} {:>12}\n", "Size",
+               "BFS_seq", "BFS_par", "Floyd_seq", "Floyd_par", "Auto");
     std::print(
         stdout,
-        "---------------------------------------------------------------\n");
+        "----------------------------------------------------------------------"
+        "------\n");
 
     // Define various graph sizes to be tested.
     std::vector<int> sizes = {100, 200, 300, 400, 500,
@@ -41,6 +271,8 @@ int main() {
     TBreadthFirstSearchParallel bfsPar;
     TFloydWarshall floydSeq;
     TFloydWarshallParallel floydPar;
+    // The automatic finder uses a model calibrated on this machine.
+    TAutomaticShortestPathFinder automatic{TCostModel::Calibrate()};
 
     // Lambda function to measure execution time.
     auto measure = [&](auto&& func) -> double {
@@ -67,9 +299,9 @@ int main() {
         graph.Load(iss);
 
         double totalBFSSeq = 0.0, totalBFSPar = 0.0;
-        double totalFloydSeq = 0.0, totalFloydPar = 0.0;
+        double totalFloydSeq = 0.0, totalFloydPar = 0.0, totalAuto = 0.0;
         std::vector<int> resultBFSSeq, resultBFSPar, resultFloydSeq,
-            resultFloydPar;
+            resultFloydPar, resultAuto;
 
         // Measure execution time for all algorithms.
         for (int i = 0; i < iterations; ++i) {
@@ -81,11 +313,13 @@ int main() {
                 [&] { resultFloydSeq = floydSeq.Compute(graph, startVertex); });
             totalFloydPar += measure(
                 [&] { resultFloydPar = floydPar.Compute(graph, startVertex); });
+            totalAuto += measure(
+                [&] { resultAuto = automatic.Compute(graph, startVertex); });
         }
 
         // Check that all algorithms produced the same result.
         if (resultBFSSeq != resultBFSPar || resultBFSSeq != resultFloydSeq ||
-            resultBFSSeq != resultFloydPar) {
+            resultBFSSeq != resultFloydPar || resultBFSSeq != resultAuto) {
             std::print(stderr, "Results mismatch for graph size {}\n", n);
             return 1;
         }
@@ -95,11 +329,22 @@ int main() {
         double avgBFSPar = totalBFSPar / iterations;
         double avgFloydSeq = totalFloydSeq / iterations;
         double avgFloydPar = totalFloydPar / iterations;
+        double avgAuto = totalAuto / iterations;
 
         // Print benchmark results.
-        std::print(stdout, "{:6d} {:12.3f} {:12.3f} {:12.3f} {:12.3f}\n", n,
-                   avgBFSSeq, avgBFSPar, avgFloydSeq, avgFloydPar);
+        std::print(stdout,
+                   "{:6d} {:12.3f} {:12.3f} {:12.3f} {:12.3f} {:12.3f}\n", n,
+                   avgBFSSeq, avgBFSPar, avgFloydSeq, avgFloydPar, avgAuto);
     }
 
+    // Measure tail latency of the asynchronous executor.
+    BenchmarkMixedLoad();
+    // Measure the result cache on a skewed workload.
+    BenchmarkHotSources();
+    // Measure the communication of the partitioned BFS.
+    BenchmarkPartitioned();
+    // Measure the cost of predecessor tracking.
+    BenchmarkPredecessors();
+
     return 0;
 }
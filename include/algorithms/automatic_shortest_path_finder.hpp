@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+
+#include "cost_model.hpp"
+#include "graph_statistics.hpp"
+#include "shortest_path_finder.hpp"
+
+namespace NShortestPaths {
+
+// The TAutomaticShortestPathFinder class picks the finder and thread count
+// with the lowest predicted cost for the graph and delegates to it.
+class TAutomaticShortestPathFinder : public IShortestPathFinder {
+   public:
+    // The TDecision structure describes the chosen finder.
+    struct TDecision {
+        // Selected algorithm.
+        EAlgorithm Algorithm{EAlgorithm::BfsSequential};
+        // Number of threads to run it with.
+        unsigned int Threads{1};
+        // Predicted running time in nanoseconds.
+        double PredictedNs{0.0};
+    };
+
+    // Create the finder using the given cost model; when logging is enabled
+    // every decision is reported to stderr.
+    explicit TAutomaticShortestPathFinder(TCostModel model,
+                                          bool logDecisions = false) noexcept
+        : Model_(model), LogDecisions_(logDecisions) {}
+
+    // Choose the cheapest finder for a graph with the given statistics.
+    [[nodiscard]] TDecision Select(const TGraphStatistics& stats) const;
+    // Create the finder described by the decision.
+    [[nodiscard]] static std::unique_ptr<IShortestPathFinder> MakeFinder(
+        const TDecision& decision);
+
+   protected:
+    // Compute the shortest paths using the finder selected for the graph.
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
+
+   private:
+    // Model predicting the cost of every finder.
+    TCostModel Model_;
+    // Whether decisions are reported to stderr.
+    bool LogDecisions_{false};
+};
+
+}  // namespace NShortestPaths
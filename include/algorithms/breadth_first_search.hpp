@@ -1,14 +1,23 @@
 #pragma once
 
 #include "shortest_path_finder.hpp"
+#include "shortest_path_tree.hpp"
 
 namespace NShortestPaths {
 
 // The TBreadthFirstSearch class implements the Breadth-First Search algorithm.
 class TBreadthFirstSearch : public IShortestPathFinder {
    public:
+    // Compute the shortest paths using BFS together with the predecessor
+    // of every vertex recorded during the traversal.
+    [[nodiscard]] TShortestPathTree ComputeTree(
+        const TGraph& graph, int start,
+        const TCancellationToken& token = TCancellationToken()) const;
+
+   protected:
     // Compute the shortest paths using BFS starting from the given vertex.
-    std::vector<int> Compute(const TGraph& graph, int start) const override;
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
 };
 
 }  // namespace NShortestPaths
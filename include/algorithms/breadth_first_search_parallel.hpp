@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shortest_path_finder.hpp"
+#include "shortest_path_tree.hpp"
 
 namespace NShortestPaths {
 
@@ -8,9 +9,26 @@ namespace NShortestPaths {
 // Search algorithm.
 class TBreadthFirstSearchParallel : public IShortestPathFinder {
    public:
+    // Create the finder using the given number of threads; zero selects the
+    // hardware concurrency.
+    explicit TBreadthFirstSearchParallel(unsigned int numThreads = 0) noexcept
+        : NumThreads_(numThreads) {}
+
+    // Compute the shortest paths using parallel BFS together with the
+    // predecessor of every vertex recorded during the traversal.
+    [[nodiscard]] TShortestPathTree ComputeTree(
+        const TGraph& graph, int start,
+        const TCancellationToken& token = TCancellationToken()) const;
+
+   protected:
     // Compute the shortest paths using parallel BFS starting from the given
     // vertex.
-    std::vector<int> Compute(const TGraph& graph, int start) const override;
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
+
+   private:
+    // Requested number of worker threads, zero for the hardware default.
+    unsigned int NumThreads_{0};
 };
 
 }  // namespace NShortestPaths
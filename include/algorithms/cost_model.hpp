@@ -0,0 +1,70 @@
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+#include "graph_statistics.hpp"
+
+namespace NShortestPaths {
+
+// The EAlgorithm enumeration lists the finders the cost model can predict.
+enum class EAlgorithm {
+    BfsSequential,
+    BfsParallel,
+    FloydSequential,
+    FloydParallel,
+};
+
+// Get the command line name of the algorithm.
+[[nodiscard]] std::string_view AlgorithmName(EAlgorithm algorithm) noexcept;
+
+// The TCostModel class predicts the running time of every finder from graph
+// statistics using per-machine coefficients measured by a micro-benchmark.
+class TCostModel {
+   public:
+    // Version of the on-disk profile format.
+    static constexpr int ProfileVersion = 1;
+
+    // Create a model with conservative built-in coefficients for the hardware
+    // concurrency of this machine.
+    TCostModel();
+
+    // Measure the coefficients on this machine.
+    [[nodiscard]] static TCostModel Calibrate();
+    // Load the model from the profile file, calibrating and saving a new
+    // profile if the file is missing, malformed or was made elsewhere.
+    [[nodiscard]] static TCostModel LoadOrCalibrate(
+        const std::filesystem::path& profile);
+
+    // Read the coefficients from a profile stream.
+    void Load(std::istream& in);
+    // Write the coefficients to a profile stream.
+    void Save(std::ostream& out) const;
+
+    // Predict the running time in nanoseconds of the algorithm on a graph
+    // with the given statistics using the given number of threads.
+    [[nodiscard]] double Predict(EAlgorithm algorithm,
+                                 const TGraphStatistics& stats,
+                                 unsigned int numThreads) const noexcept;
+
+    // Get the number of hardware threads the model was calibrated for.
+    [[nodiscard]] unsigned int HardwareThreads() const noexcept {
+        return HardwareThreads_;
+    }
+
+   private:
+    // Cost of one step (vertex or adjacency entry) of the sequential BFS.
+    double BfsSequentialStepNs_{5.0};
+    // Cost of one step of the parallel BFS on a single thread.
+    double BfsParallelStepNs_{20.0};
+    // Cost of launching and joining one thread.
+    double ThreadSpawnNs_{20000.0};
+    // Cost of one relaxation of the Floyd–Warshall inner loop.
+    double FloydRelaxationNs_{1.0};
+    // Number of hardware threads available on the calibrated machine.
+    unsigned int HardwareThreads_{1};
+};
+
+}  // namespace NShortestPaths
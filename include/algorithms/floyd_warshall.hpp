@@ -7,10 +7,11 @@ namespace NShortestPaths {
 // The TFloydWarshall class implements the Floyd–Warshall algorithm for shortest
 // paths.
 class TFloydWarshall : public IShortestPathFinder {
-   public:
+   protected:
     // Compute the shortest paths using the Floyd–Warshall algorithm starting
     // from the given vertex.
-    std::vector<int> Compute(const TGraph& graph, int start) const override;
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
 };
 
 }  // namespace NShortestPaths
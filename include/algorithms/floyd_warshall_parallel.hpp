@@ -8,9 +8,20 @@ namespace NShortestPaths {
 // algorithm.
 class TFloydWarshallParallel : public IShortestPathFinder {
    public:
+    // Create the finder using the given number of threads; zero selects the
+    // hardware concurrency.
+    explicit TFloydWarshallParallel(unsigned int numThreads = 0) noexcept
+        : NumThreads_(numThreads) {}
+
+   protected:
     // Compute the shortest paths using the parallel Floyd–Warshall algorithm
     // starting from the given vertex.
-    std::vector<int> Compute(const TGraph& graph, int start) const override;
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
+
+   private:
+    // Requested number of worker threads, zero for the hardware default.
+    unsigned int NumThreads_{0};
 };
 
 }  // namespace NShortestPaths
@@ -2,19 +2,36 @@
 
 #include <vector>
 
+#include "cancellation_token.hpp"
 #include "graph.hpp"
 
 namespace NShortestPaths {
 
 // The IShortestPathFinder interface defines the method for computing shortest
-// paths.
+// paths. Finders implement DoCompute; callers use the Compute overloads.
 class IShortestPathFinder {
    public:
+    // Compute the shortest path distances from the given starting vertex,
+    // polling the token between steps and throwing TQueryCancelledError once
+    // it is cancelled.
+    [[nodiscard]] std::vector<int> Compute(
+        const TGraph& graph, int start,
+        const TCancellationToken& token) const {
+        return DoCompute(graph, start, token);
+    }
     // Compute the shortest path distances from the given starting vertex.
-    [[nodiscard]] virtual std::vector<int> Compute(const TGraph& graph,
-                                                   int start) const = 0;
+    [[nodiscard]] std::vector<int> Compute(const TGraph& graph,
+                                           int start) const {
+        return DoCompute(graph, start, TCancellationToken());
+    }
     // Virtual destructor for proper cleanup.
     virtual ~IShortestPathFinder() = default;
+
+   protected:
+    // Compute the shortest path distances; implemented by every finder.
+    [[nodiscard]] virtual std::vector<int> DoCompute(
+        const TGraph& graph, int start,
+        const TCancellationToken& token) const = 0;
 };
 
 }  // namespace NShortestPaths
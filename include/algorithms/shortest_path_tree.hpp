@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+namespace NShortestPaths {
+
+// The TShortestPathTree structure holds the distances from a starting vertex
+// together with the predecessor of every vertex on a shortest path.
+struct TShortestPathTree {
+    // Distances from the starting vertex, -1 for unreachable vertices.
+    std::vector<int> Distances;
+    // Predecessors, -1 for the starting vertex and unreachable vertices.
+    std::vector<int> Parents;
+};
+
+// Extract the vertices of a shortest path from the starting vertex to the
+// target; the path is empty if the target is unreachable. Throws
+// std::invalid_argument if the predecessors do not form such a path.
+[[nodiscard]] std::vector<int> ExtractPath(const TShortestPathTree& tree,
+                                           int target);
+
+}  // namespace NShortestPaths
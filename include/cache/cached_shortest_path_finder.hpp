@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "result_cache.hpp"
+#include "shortest_path_finder.hpp"
+
+namespace NShortestPaths {
+
+// The TCachedShortestPathFinder class serves repeated single-source queries
+// from a result cache and delegates misses to the wrapped finder.
+class TCachedShortestPathFinder : public IShortestPathFinder {
+   public:
+    // Wrap the finder registered in the cache under the algorithm name; the
+    // finder and the cache must outlive this object.
+    TCachedShortestPathFinder(const IShortestPathFinder& finder,
+                              std::string algorithm, TResultCache& cache)
+        : Finder_(finder), Algorithm_(std::move(algorithm)), Cache_(cache) {}
+
+   protected:
+    // Return the cached distances or compute and cache them.
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
+
+   private:
+    // Finder computing the results on a miss.
+    const IShortestPathFinder& Finder_;
+    // Name of the algorithm used in the cache keys.
+    std::string Algorithm_;
+    // Cache storing the results.
+    TResultCache& Cache_;
+};
+
+}  // namespace NShortestPaths
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NShortestPaths {
+
+// The TCompactDistances class stores a distance vector using the narrowest
+// unsigned integer width that fits its largest value.
+class TCompactDistances {
+   public:
+    // Encode the distances; unreachable vertices (-1) are kept as well.
+    explicit TCompactDistances(const std::vector<int>& distances);
+
+    // Decode the distances back into a plain vector.
+    [[nodiscard]] std::vector<int> Decode() const;
+
+    // Get the number of bytes used by one distance.
+    [[nodiscard]] int Width() const noexcept { return Width_; }
+    // Get the memory occupied by the encoded distances.
+    [[nodiscard]] std::size_t Bytes() const noexcept {
+        return sizeof(*this) + Data_.capacity();
+    }
+
+   private:
+    // Distances shifted by one so that -1 maps to zero.
+    std::vector<std::uint8_t> Data_;
+    // Number of encoded distances.
+    std::size_t Size_{0};
+    // Number of bytes per distance: 1, 2 or 4.
+    int Width_{1};
+};
+
+// The TResultCache class keeps single-source results keyed by graph version,
+// algorithm and source within a byte budget, evicting the least recently used
+// entries. Locking is sharded so that concurrent queries rarely contend.
+class TResultCache {
+   public:
+    // The TKey structure identifies a cached result.
+    struct TKey {
+        // Version of the graph the result was computed on.
+        std::uint64_t GraphVersion;
+        // Name of the algorithm that computed the result.
+        std::string Algorithm;
+        // Starting vertex.
+        int Source;
+
+        bool operator==(const TKey&) const = default;
+    };
+
+    // The TStatistics structure describes the effectiveness of the cache.
+    struct TStatistics {
+        // Number of lookups that found a result.
+        std::uint64_t Hits{0};
+        // Number of lookups that found nothing.
+        std::uint64_t Misses{0};
+        // Number of entries evicted to respect the budget.
+        std::uint64_t Evictions{0};
+        // Number of entries currently stored.
+        std::size_t Entries{0};
+        // Memory currently occupied by the entries.
+        std::size_t Bytes{0};
+
+        // Get the share of lookups that found a result.
+        [[nodiscard]] double HitRate() const noexcept {
+            auto lookups = Hits + Misses;
+            return lookups == 0 ? 0.0 : static_cast<double>(Hits) / lookups;
+        }
+    };
+
+    // Default number of shards.
+    static constexpr std::size_t DefaultShards = 16;
+
+    // Create the cache with the given byte budget split evenly among shards.
+    explicit TResultCache(std::size_t budgetBytes,
+                          std::size_t shards = DefaultShards);
+
+    // Look up a result and mark it as recently used.
+    [[nodiscard]] std::optional<std::vector<int>> Find(const TKey& key);
+    // Store a result, evicting older entries if the budget is exceeded.
+    // Results that do not fit into a shard are not stored.
+    void Insert(const TKey& key, const std::vector<int>& distances);
+    // Remove every result computed on the given graph version. Shards
+    // holding no such result are skipped without a scan.
+    void Invalidate(std::uint64_t graphVersion);
+    // Remove every result.
+    void Clear();
+
+    // Get the current statistics.
+    [[nodiscard]] TStatistics Statistics() const;
+
+   private:
+    // The TKeyHash structure hashes cache keys.
+    struct TKeyHash {
+        std::size_t operator()(const TKey& key) const noexcept;
+    };
+
+    // The TEntry structure holds a cached result.
+    struct TEntry {
+        // Key of the result.
+        TKey Key;
+        // Encoded distances shared with readers decoding outside the lock.
+        std::shared_ptr<const TCompactDistances> Distances;
+    };
+
+    // The TShard structure holds an independently locked part of the cache.
+    struct TShard {
+        // Guards the fields below.
+        mutable std::mutex Mutex;
+        // Entries ordered from the most to the least recently used.
+        std::list<TEntry> Entries;
+        // Index of the entries by key.
+        std::unordered_map<TKey, std::list<TEntry>::iterator, TKeyHash> Index;
+        // Number of entries of the shard per graph version.
+        std::unordered_map<std::uint64_t, std::size_t> Versions;
+        // Memory occupied by the entries of the shard.
+        std::size_t Bytes{0};
+    };
+
+    // Get the shard responsible for the key.
+    [[nodiscard]] TShard& ShardFor(const TKey& key) noexcept;
+    // Remove an entry of the shard; the shard lock must be held.
+    static std::list<TEntry>::iterator Erase(TShard& shard,
+                                             std::list<TEntry>::iterator it);
+
+    // Byte budget of every shard.
+    std::size_t ShardBudget_;
+    // Shards of the cache.
+    std::vector<TShard> Shards_;
+    // Lookup counters.
+    std::atomic<std::uint64_t> Hits_{0};
+    std::atomic<std::uint64_t> Misses_{0};
+    std::atomic<std::uint64_t> Evictions_{0};
+};
+
+}  // namespace NShortestPaths
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+
+namespace NShortestPaths {
+
+// Thrown when a computation is cancelled before completion.
+class TQueryCancelledError : public std::runtime_error {
+   public:
+    using std::runtime_error::runtime_error;
+};
+
+// Thrown when a computation runs past its deadline.
+class TDeadlineExceededError : public TQueryCancelledError {
+   public:
+    using TQueryCancelledError::TQueryCancelledError;
+};
+
+// The TCancellationToken class combines a stop request and a deadline that
+// long computations poll cooperatively between their steps.
+class TCancellationToken {
+   public:
+    // Clock used for deadlines.
+    using TClock = std::chrono::steady_clock;
+
+    // Create a token that is never cancelled.
+    TCancellationToken() = default;
+    // Create a token cancelled by the stop token or after the deadline.
+    explicit TCancellationToken(
+        std::stop_token stop,
+        TClock::time_point deadline = TClock::time_point::max()) noexcept
+        : Stop_(std::move(stop)), Deadline_(deadline) {}
+
+    // Check whether the computation has to stop.
+    [[nodiscard]] bool IsCancelled() const noexcept {
+        return Stop_.stop_requested() || DeadlineExpired();
+    }
+
+    // Throw if the computation has to stop.
+    void ThrowIfCancelled() const {
+        if (Stop_.stop_requested()) {
+            throw TQueryCancelledError("Query cancelled");
+        }
+        if (DeadlineExpired()) {
+            throw TDeadlineExceededError("Query deadline exceeded");
+        }
+    }
+
+   private:
+    // Check the deadline, skipping the clock read when there is none.
+    [[nodiscard]] bool DeadlineExpired() const noexcept {
+        return Deadline_ != TClock::time_point::max() &&
+               TClock::now() >= Deadline_;
+    }
+
+    // Stop request shared with the owner of the query.
+    std::stop_token Stop_;
+    // Point in time after which the computation has to stop.
+    TClock::time_point Deadline_{TClock::time_point::max()};
+};
+
+}  // namespace NShortestPaths
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <istream>
 #include <span>
 #include <vector>
 
+#include "graph_statistics.hpp"
+
 namespace NShortestPaths {
 
 // Graph class holds an undirected unweighted graph.
@@ -17,11 +20,24 @@ class TGraph {
 
     // Get the number of vertices in the graph.
     [[nodiscard]] int VerticesCount() const noexcept { return VerticesCount_; }
+    // Get the number of edges in the graph.
+    [[nodiscard]] int EdgesCount() const noexcept { return EdgesCount_; }
     // Get the adjacency list representing graph connections.
     [[nodiscard]] std::span<const std::vector<int>> AdjacencyList()
         const noexcept {
         return std::span(AdjList_);
     }
+    // Get the version of the graph contents; every load assigns a new version
+    // unique across all graphs, zero means the graph was never loaded.
+    [[nodiscard]] std::uint64_t Version() const noexcept { return Version_; }
+    // Get the version the graph had before the last load, zero if none.
+    [[nodiscard]] std::uint64_t PreviousVersion() const noexcept {
+        return PreviousVersion_;
+    }
+    // Get the statistics collected when the graph was loaded.
+    [[nodiscard]] const TGraphStatistics& Statistics() const noexcept {
+        return Statistics_;
+    }
 
    private:
     // Number of vertices in the graph.
@@ -30,6 +46,12 @@ class TGraph {
     int EdgesCount_{0};
     // Adjacency list for storing edges.
     std::vector<std::vector<int>> AdjList_;
+    // Structural statistics used for algorithm selection.
+    TGraphStatistics Statistics_;
+    // Version identifying the current contents of the graph.
+    std::uint64_t Version_{0};
+    // Version of the contents replaced by the last load.
+    std::uint64_t PreviousVersion_{0};
 };
 
 }  // namespace NShortestPaths
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+namespace NShortestPaths {
+
+// TGraphStatistics holds cheap structural statistics of a graph that are
+// collected once at load time and used to predict the cost of the finders.
+struct TGraphStatistics {
+    // Number of vertices in the graph.
+    int Vertices{0};
+    // Number of undirected edges in the graph.
+    long long Edges{0};
+    // Smallest vertex degree.
+    int MinDegree{0};
+    // Largest vertex degree.
+    int MaxDegree{0};
+    // Mean vertex degree.
+    double AverageDegree{0.0};
+    // Standard deviation of the vertex degree.
+    double DegreeStdDev{0.0};
+    // Number of vertices without any incident edges.
+    int IsolatedVertices{0};
+    // Lower bound on the largest diameter of a component obtained by a
+    // double-sweep BFS in every component.
+    int EstimatedDiameter{0};
+
+    // Number of elementary BFS steps (vertices plus adjacency entries).
+    [[nodiscard]] double TraversalSteps() const noexcept {
+        return static_cast<double>(Vertices) + 2.0 * static_cast<double>(Edges);
+    }
+};
+
+// Collect the statistics of a graph given by its adjacency list.
+[[nodiscard]] TGraphStatistics CollectStatistics(
+    std::span<const std::vector<int>> adjacency);
+
+}  // namespace NShortestPaths
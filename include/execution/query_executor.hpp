@@ -0,0 +1,129 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cancellation_token.hpp"
+#include "graph.hpp"
+#include "shortest_path_finder.hpp"
+
+namespace NShortestPaths {
+
+// The EQueryPriority enumeration lists the lanes of the executor.
+enum class EQueryPriority {
+    // Short single-source queries, always served first.
+    Point,
+    // Expensive all-pairs jobs that never occupy every worker.
+    Bulk,
+};
+
+// The TQueryOptions structure holds the scheduling parameters of a query.
+struct TQueryOptions {
+    // Lane the query is queued in.
+    EQueryPriority Priority{EQueryPriority::Point};
+    // Point in time after which the query fails with TDeadlineExceededError.
+    TCancellationToken::TClock::time_point Deadline{
+        TCancellationToken::TClock::time_point::max()};
+};
+
+// The TQueryHandle class gives access to the result of a submitted query and
+// allows cancelling it.
+class TQueryHandle {
+   public:
+    // Create a handle from the result future and the stop source of a query.
+    TQueryHandle(std::future<std::vector<int>> result,
+                 std::stop_source stop) noexcept
+        : Result_(std::move(result)), Stop_(std::move(stop)) {}
+
+    // Get the future holding the distances or the error of the query.
+    [[nodiscard]] std::future<std::vector<int>>& Result() noexcept {
+        return Result_;
+    }
+    // Request cancellation; the query fails with TQueryCancelledError unless
+    // it has already finished.
+    void Cancel() noexcept { Stop_.request_stop(); }
+
+   private:
+    // Future receiving the result.
+    std::future<std::vector<int>> Result_;
+    // Stop source shared with the cancellation token of the query.
+    std::stop_source Stop_;
+};
+
+// The TQueryExecutor class runs shortest path queries asynchronously on a
+// shared pool of worker threads with separate priority lanes.
+class TQueryExecutor {
+   public:
+    // Create the executor with the given number of workers; zero selects the
+    // hardware concurrency. At least two workers are started so that one is
+    // always available for point queries.
+    explicit TQueryExecutor(unsigned int numThreads = 0);
+    // Fail all pending queries with TQueryCancelledError, cancel the running
+    // ones and stop the workers.
+    ~TQueryExecutor();
+
+    TQueryExecutor(const TQueryExecutor&) = delete;
+    TQueryExecutor& operator=(const TQueryExecutor&) = delete;
+
+    // Submit a query; the finder and the graph must outlive its completion.
+    [[nodiscard]] TQueryHandle Submit(const IShortestPathFinder& finder,
+                                      const TGraph& graph, int start,
+                                      TQueryOptions options = {});
+
+    // Get the number of worker threads.
+    [[nodiscard]] unsigned int ThreadsCount() const noexcept {
+        return static_cast<unsigned int>(Workers_.size());
+    }
+
+   private:
+    // The TTask structure describes a queued query.
+    struct TTask {
+        // Finder running the query.
+        const IShortestPathFinder* Finder;
+        // Graph to search.
+        const TGraph* Graph;
+        // Starting vertex.
+        int Start;
+        // Lane the query was queued in.
+        EQueryPriority Priority;
+        // Token polled by the finder.
+        TCancellationToken Token;
+        // Stop source of the token, used to cancel the query at shutdown.
+        std::stop_source Stop;
+        // Promise receiving the result.
+        std::promise<std::vector<int>> Promise;
+    };
+
+    // Main loop of a worker thread.
+    void WorkerLoop();
+    // Run the task and fulfil its promise.
+    static void Run(TTask& task);
+
+    // Guards the queues and the counters below.
+    std::mutex Mutex_;
+    // Signalled when a task can be taken or the executor stops.
+    std::condition_variable Ready_;
+    // Queue of point queries.
+    std::deque<TTask> PointQueue_;
+    // Queue of bulk queries.
+    std::deque<TTask> BulkQueue_;
+    // Number of bulk queries currently running.
+    unsigned int RunningBulk_{0};
+    // Maximum number of bulk queries running at once.
+    unsigned int MaxRunningBulk_{1};
+    // Stop sources of the running queries.
+    std::list<std::stop_source> Running_;
+    // Set when the executor is being destroyed.
+    bool Stopping_{false};
+    // Worker threads.
+    std::vector<std::thread> Workers_;
+};
+
+}  // namespace NShortestPaths
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace NShortestPaths {
+
+// The TGraphPartition class describes a contiguous range of vertices of a
+// graph and reads their adjacency from the graph in place.
+class TGraphPartition {
+   public:
+    // Select one of the given number of vertex ranges of equal size; the
+    // graph must outlive the partition.
+    [[nodiscard]] static TGraphPartition Build(const TGraph& graph, int parts,
+                                               int index);
+    // Count, for every pair of partitions, the distinct vertices of the
+    // second one adjacent to the first one without building the partitions.
+    [[nodiscard]] static std::vector<std::vector<int>> BoundaryTargets(
+        const TGraph& graph, int parts);
+
+    // Get the first vertex owned by the partition.
+    [[nodiscard]] int Begin() const noexcept { return Begin_; }
+    // Get the vertex following the last one owned by the partition.
+    [[nodiscard]] int End() const noexcept { return End_; }
+    // Check whether the partition owns the vertex.
+    [[nodiscard]] bool Owns(int v) const noexcept {
+        return v >= Begin_ && v < End_;
+    }
+    // Get the index of the partition owning the vertex.
+    [[nodiscard]] int Owner(int v) const noexcept { return v / ChunkSize_; }
+
+    // Get the neighbors of an owned vertex.
+    [[nodiscard]] std::span<const int> Neighbors(int v) const noexcept {
+        return Adjacency_[v];
+    }
+
+   private:
+    // First owned vertex.
+    int Begin_{0};
+    // Vertex following the last owned one.
+    int End_{0};
+    // Number of vertices per partition.
+    int ChunkSize_{1};
+    // Adjacency of the whole graph, shared rather than copied.
+    std::span<const std::vector<int>> Adjacency_;
+};
+
+}  // namespace NShortestPaths
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "shortest_path_finder.hpp"
+
+namespace NShortestPaths {
+
+// The TPartitionedLevelStats structure describes the communication of one BFS
+// level between the worker processes.
+struct TPartitionedLevelStats {
+    // Number of vertices expanded at this level.
+    long long Frontier{0};
+    // Number of boundary vertices sent to other partitions.
+    long long Messages{0};
+    // Number of batches the messages were grouped into.
+    long long Batches{0};
+    // Number of bytes written to the ring buffers.
+    long long Bytes{0};
+};
+
+// The TPartitionedBfsResult structure holds the distances together with the
+// per-level communication statistics.
+struct TPartitionedBfsResult {
+    // Distances from the starting vertex, -1 for unreachable vertices.
+    std::vector<int> Distances;
+    // Statistics of every level.
+    std::vector<TPartitionedLevelStats> Levels;
+};
+
+// The TPartitionedBreadthFirstSearch class runs a level-synchronous BFS over
+// vertex-range partitions, each owned by a forked worker process pinned to
+// its own CPU. Boundary vertices are exchanged in batches through
+// shared-memory ring buffers and the calling process coordinates the levels.
+// The workers read the graph of the calling process in place, so the graph
+// must still fit in its memory. Linux only.
+class TPartitionedBreadthFirstSearch : public IShortestPathFinder {
+   public:
+    // Maximum number of vertices per message batch.
+    static constexpr int BatchSize = 256;
+
+    // Create the finder using the given number of worker processes; zero
+    // selects the hardware concurrency.
+    explicit TPartitionedBreadthFirstSearch(int numPartitions = 0) noexcept
+        : NumPartitions_(numPartitions) {}
+
+    // Compute the shortest paths and collect the communication statistics.
+    [[nodiscard]] TPartitionedBfsResult ComputeWithStats(
+        const TGraph& graph, int start,
+        const TCancellationToken& token = TCancellationToken()) const;
+
+   protected:
+    // Compute the shortest paths using the partitioned BFS starting from the
+    // given vertex.
+    std::vector<int> DoCompute(const TGraph& graph, int start,
+                               const TCancellationToken& token) const override;
+
+   private:
+    // Requested number of worker processes, zero for the hardware default.
+    int NumPartitions_{0};
+};
+
+}  // namespace NShortestPaths
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace NShortestPaths {
+
+// The TSharedRegion class owns an anonymous memory mapping that stays shared
+// with the processes forked after its creation.
+class TSharedRegion {
+   public:
+    // Map a zero-filled region of the given size.
+    explicit TSharedRegion(std::size_t size);
+    // Unmap the region.
+    ~TSharedRegion();
+
+    TSharedRegion(const TSharedRegion&) = delete;
+    TSharedRegion& operator=(const TSharedRegion&) = delete;
+
+    // Get the start of the region.
+    [[nodiscard]] std::byte* Data() const noexcept { return Data_; }
+    // Get the size of the region.
+    [[nodiscard]] std::size_t Size() const noexcept { return Size_; }
+
+   private:
+    // Start of the mapping.
+    std::byte* Data_{nullptr};
+    // Size of the mapping.
+    std::size_t Size_{0};
+};
+
+}  // namespace NShortestPaths
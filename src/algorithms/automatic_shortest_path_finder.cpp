@@ -0,0 +1,74 @@
+#include "automatic_shortest_path_finder.hpp"
+
+#include <memory>
+#include <print>
+#include <vector>
+
+#include "breadth_first_search.hpp"
+#include "breadth_first_search_parallel.hpp"
+#include "floyd_warshall.hpp"
+#include "floyd_warshall_parallel.hpp"
+#include "graph.hpp"
+
+namespace NShortestPaths {
+
+TAutomaticShortestPathFinder::TDecision TAutomaticShortestPathFinder::Select(
+    const TGraphStatistics& stats) const {
+    // Sequential finders are the baseline.
+    TDecision best{EAlgorithm::BfsSequential, 1,
+                   Model_.Predict(EAlgorithm::BfsSequential, stats, 1)};
+    double floydSeq = Model_.Predict(EAlgorithm::FloydSequential, stats, 1);
+    if (floydSeq < best.PredictedNs) {
+        best = {EAlgorithm::FloydSequential, 1, floydSeq};
+    }
+
+    // Try every thread count up to the hardware concurrency for the parallel
+    // finders.
+    for (unsigned int t = 2; t <= Model_.HardwareThreads(); ++t) {
+        for (auto algorithm :
+             {EAlgorithm::BfsParallel, EAlgorithm::FloydParallel}) {
+            double predicted = Model_.Predict(algorithm, stats, t);
+            if (predicted < best.PredictedNs) {
+                best = {algorithm, t, predicted};
+            }
+        }
+    }
+
+    return best;
+}
+
+std::unique_ptr<IShortestPathFinder> TAutomaticShortestPathFinder::MakeFinder(
+    const TDecision& decision) {
+    switch (decision.Algorithm) {
+        case EAlgorithm::BfsSequential:
+            return std::make_unique<TBreadthFirstSearch>();
+        case EAlgorithm::BfsParallel:
+            return std::make_unique<TBreadthFirstSearchParallel>(
+                decision.Threads);
+        case EAlgorithm::FloydSequential:
+            return std::make_unique<TFloydWarshall>();
+        case EAlgorithm::FloydParallel:
+            return std::make_unique<TFloydWarshallParallel>(decision.Threads);
+    }
+    return std::make_unique<TBreadthFirstSearch>();
+}
+
+std::vector<int> TAutomaticShortestPathFinder::DoCompute(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    const auto& stats = graph.Statistics();
+    auto decision = Select(stats);
+    if (LogDecisions_) {
+        std::print(stderr,
+                   "auto: n={} m={} degree={:.2f}±{:.2f} (max {}) "
+                   "diameter>={} -> {} with {} thread(s), predicted {:.3f} "
+                   "ms\n",
+                   stats.Vertices, stats.Edges, stats.AverageDegree,
+                   stats.DegreeStdDev, stats.MaxDegree,
+                   stats.EstimatedDiameter, AlgorithmName(decision.Algorithm),
+                   decision.Threads, decision.PredictedNs / 1e6);
+    }
+
+    return MakeFinder(decision)->Compute(graph, start, token);
+}
+
+}  // namespace NShortestPaths
@@ -9,8 +9,14 @@
 
 namespace NShortestPaths {
 
-std::vector<int> TBreadthFirstSearch::Compute(const TGraph& graph,
-                                              int start) const {
+namespace {
+
+// Run BFS from the starting vertex; predecessors are recorded only when
+// requested so that plain distance queries do not pay for them.
+template <bool TrackParents>
+std::vector<int> Traverse(const TGraph& graph, int start,
+                          const TCancellationToken& token,
+                          std::vector<int>& parents) {
     int n = graph.VerticesCount();
     // Validate the starting vertex.
     if (start < 0 || start >= n) {
@@ -19,6 +25,10 @@ std::vector<int> TBreadthFirstSearch::Compute(const TGraph& graph,
 
     // Initialize distances with -1 to indicate unvisited vertices.
     std::vector<int> distances(n, -1);
+    if constexpr (TrackParents) {
+        // The starting vertex and unreachable vertices have no parent.
+        parents.assign(n, -1);
+    }
     // Create a queue for BFS.
     std::queue<int> queue;
     // Distance to the starting vertex is 0.
@@ -27,15 +37,24 @@ std::vector<int> TBreadthFirstSearch::Compute(const TGraph& graph,
     queue.push(start);
 
     // Perform BFS.
+    int level = 0;
     while (!queue.empty()) {
         int u = queue.front();
         queue.pop();
+        // Check for cancellation whenever a new level begins.
+        if (distances[u] != level) {
+            level = distances[u];
+            token.ThrowIfCancelled();
+        }
         // Visit each neighbor of the current vertex.
         for (const auto& v : graph.AdjacencyList()[u]) {
             // If the neighbor has not been visited.
             if (distances[v] == -1) {
                 // Update distance.
                 distances[v] = distances[u] + 1;
+                if constexpr (TrackParents) {
+                    parents[v] = u;
+                }
                 // Enqueue the neighbor.
                 queue.push(v);
             }
@@ -45,4 +64,19 @@ std::vector<int> TBreadthFirstSearch::Compute(const TGraph& graph,
     return distances;
 }
 
+}  // namespace
+
+std::vector<int> TBreadthFirstSearch::DoCompute(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    std::vector<int> unused;
+    return Traverse<false>(graph, start, token, unused);
+}
+
+TShortestPathTree TBreadthFirstSearch::ComputeTree(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    TShortestPathTree tree;
+    tree.Distances = Traverse<true>(graph, start, token, tree.Parents);
+    return tree;
+}
+
 }  // namespace NShortestPaths
@@ -1,6 +1,7 @@
 #include "breadth_first_search_parallel.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <span>
 #include <stdexcept>
@@ -12,8 +13,41 @@
 
 namespace NShortestPaths {
 
-std::vector<int> TBreadthFirstSearchParallel::Compute(const TGraph& graph,
-                                                      int start) const {
+namespace {
+
+// Try to claim an unvisited vertex for the current thread. Without parents
+// the distance itself is the visited mark; with parents the parent slot is,
+// so the parent is recorded by the same atomic operation that marks the
+// vertex visited and the winner alone writes the distance.
+template <bool TrackParents>
+bool Claim(std::vector<int>& distances, std::vector<int>& parents, int u,
+           int v, int level) {
+    int expected = -1;
+    if constexpr (TrackParents) {
+        std::atomic_ref<int> parent(parents[v]);
+        // First check without the read-modify-write.
+        if (parent.load(std::memory_order_relaxed) != -1 ||
+            !parent.compare_exchange_strong(expected, u,
+                                            std::memory_order_relaxed)) {
+            return false;
+        }
+        distances[v] = level + 1;
+        return true;
+    } else {
+        std::atomic_ref<int> distance(distances[v]);
+        // First check without the read-modify-write.
+        return distance.load(std::memory_order_relaxed) == -1 &&
+               distance.compare_exchange_strong(expected, level + 1,
+                                                std::memory_order_relaxed);
+    }
+}
+
+// Run the level-synchronous BFS; predecessors are recorded only when
+// requested so that plain distance queries do not pay for them.
+template <bool TrackParents>
+std::vector<int> Traverse(const TGraph& graph, int start,
+                          const TCancellationToken& token,
+                          unsigned int numThreads, std::vector<int>& parents) {
     int n = graph.VerticesCount();
     // Validate the starting vertex.
     if (start < 0 || start >= n) {
@@ -26,16 +60,18 @@ std::vector<int> TBreadthFirstSearchParallel::Compute(const TGraph& graph,
     std::vector<int> current;
     current.push_back(start);
     distances[start] = 0;
-    int level = 0;
-
-    // Determine the number of threads to use.
-    unsigned int numThreads = std::thread::hardware_concurrency();
-    if (numThreads == 0) {
-        numThreads = 2;
+    if constexpr (TrackParents) {
+        // The starting vertex is marked as its own parent while traversing
+        // so that no thread claims it.
+        parents.assign(n, -1);
+        parents[start] = start;
     }
+    int level = 0;
 
     // Level-synchronous BFS.
     while (!current.empty()) {
+        // Check for cancellation between levels.
+        token.ThrowIfCancelled();
         std::vector<int> next;
         std::mutex nextMutex;
         std::vector<std::thread> threads;
@@ -54,14 +90,10 @@ std::vector<int> TBreadthFirstSearchParallel::Compute(const TGraph& graph,
                     int u = current[i];
                     // Iterate over all neighbors.
                     for (auto v : graph.AdjacencyList()[u]) {
-                        // First check without locking.
-                        if (distances[v] == -1) {
-                            // Critical section to update shared data.
-                            std::lock_guard<std::mutex> lock(nextMutex);
-                            if (distances[v] == -1) {
-                                distances[v] = level + 1;
-                                localNext.push_back(v);
-                            }
+                        // Exactly one thread wins every vertex.
+                        if (Claim<TrackParents>(distances, parents, u, v,
+                                                level)) {
+                            localNext.push_back(v);
                         }
                     }
                 }
@@ -83,7 +115,38 @@ std::vector<int> TBreadthFirstSearchParallel::Compute(const TGraph& graph,
         ++level;
     }
 
+    if constexpr (TrackParents) {
+        parents[start] = -1;
+    }
     return distances;
 }
 
+// Get the number of threads to use for the requested count.
+unsigned int ResolveThreads(unsigned int numThreads) noexcept {
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    if (numThreads == 0) {
+        numThreads = 2;
+    }
+    return numThreads;
+}
+
+}  // namespace
+
+std::vector<int> TBreadthFirstSearchParallel::DoCompute(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    std::vector<int> unused;
+    return Traverse<false>(graph, start, token, ResolveThreads(NumThreads_),
+                           unused);
+}
+
+TShortestPathTree TBreadthFirstSearchParallel::ComputeTree(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    TShortestPathTree tree;
+    tree.Distances = Traverse<true>(graph, start, token,
+                                    ResolveThreads(NumThreads_), tree.Parents);
+    return tree;
+}
+
 }  // namespace NShortestPaths
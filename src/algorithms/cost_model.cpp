@@ -0,0 +1,225 @@
+#include "cost_model.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <ratio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "breadth_first_search.hpp"
+#include "breadth_first_search_parallel.hpp"
+#include "floyd_warshall.hpp"
+#include "graph.hpp"
+#include "graph_factory.hpp"
+
+namespace NShortestPaths {
+
+namespace {
+
+// Number of vertices of the tree used to calibrate the BFS coefficients.
+constexpr int BfsCalibrationVertices = 1 << 16;
+// Number of vertices of the tree used to calibrate the Floyd coefficient.
+constexpr int FloydCalibrationVertices = 128;
+// Number of threads launched to measure the spawn cost.
+constexpr int SpawnCalibrationThreads = 16;
+// Number of repetitions of every measurement; the fastest one is kept.
+constexpr int CalibrationRepetitions = 3;
+
+// Get the number of hardware threads, at least one.
+unsigned int HardwareConcurrency() noexcept {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Build a random tree with n vertices.
+TGraph MakeTree(int n) {
+    std::istringstream iss(
+        NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n)));
+    TGraph graph;
+    graph.Load(iss);
+    return graph;
+}
+
+// Measure the fastest of several runs of the function in nanoseconds.
+template <typename TFunc>
+double BestOf(TFunc&& func) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < CalibrationRepetitions; ++i) {
+        auto startTime = std::chrono::steady_clock::now();
+        func();
+        auto endTime = std::chrono::steady_clock::now();
+        best = std::min(
+            best,
+            std::chrono::duration<double, std::nano>(endTime - startTime)
+                .count());
+    }
+    return best;
+}
+
+}  // namespace
+
+std::string_view AlgorithmName(EAlgorithm algorithm) noexcept {
+    switch (algorithm) {
+        case EAlgorithm::BfsSequential:
+            return "bfs-seq";
+        case EAlgorithm::BfsParallel:
+            return "bfs-par";
+        case EAlgorithm::FloydSequential:
+            return "floyd-seq";
+        case EAlgorithm::FloydParallel:
+            return "floyd-par";
+    }
+    return "unknown";
+}
+
+TCostModel::TCostModel() : HardwareThreads_(HardwareConcurrency()) {}
+
+TCostModel TCostModel::Calibrate() {
+    TCostModel model;
+
+    // Sequential BFS over a large tree gives the cost of a traversal step.
+    TGraph tree = MakeTree(BfsCalibrationVertices);
+    double steps = tree.Statistics().TraversalSteps();
+    TBreadthFirstSearch bfsSeq;
+    std::vector<int> distances;
+    double bfsSeqNs = BestOf([&] { distances = bfsSeq.Compute(tree, 0); });
+    model.BfsSequentialStepNs_ = bfsSeqNs / steps;
+
+    // Launching and joining empty threads gives the per-thread overhead.
+    double spawnNs = BestOf([] {
+                         for (int i = 0; i < SpawnCalibrationThreads; ++i) {
+                             std::thread([] {}).join();
+                         }
+                     }) /
+                     SpawnCalibrationThreads;
+    model.ThreadSpawnNs_ = spawnNs;
+
+    // Parallel BFS on one thread pays one spawn per level on top of the
+    // synchronized per-step work.
+    int levels = *std::max_element(distances.begin(), distances.end()) + 1;
+    TBreadthFirstSearchParallel bfsPar(1);
+    double bfsParNs = BestOf([&] { distances = bfsPar.Compute(tree, 0); });
+    model.BfsParallelStepNs_ =
+        std::max(bfsParNs - levels * spawnNs, bfsSeqNs) / steps;
+
+    // Floyd–Warshall is dominated by its cubic relaxation loop.
+    TGraph small = MakeTree(FloydCalibrationVertices);
+    TFloydWarshall floyd;
+    double floydNs = BestOf([&] { distances = floyd.Compute(small, 0); });
+    double relaxations = static_cast<double>(FloydCalibrationVertices) *
+                         FloydCalibrationVertices * FloydCalibrationVertices;
+    model.FloydRelaxationNs_ = floydNs / relaxations;
+
+    return model;
+}
+
+TCostModel TCostModel::LoadOrCalibrate(const std::filesystem::path& profile) {
+    TCostModel model;
+    std::ifstream in(profile);
+    if (in) {
+        try {
+            model.Load(in);
+            // A profile measured with other hardware is not trusted.
+            if (model.HardwareThreads_ == HardwareConcurrency()) {
+                return model;
+            }
+        } catch (const std::exception&) {
+            // Fall through to recalibration.
+        }
+    }
+
+    model = Calibrate();
+    // The profile is only a cache, so failing to write it is not an error.
+    std::ofstream out(profile);
+    if (out) {
+        model.Save(out);
+    }
+    return model;
+}
+
+void TCostModel::Load(std::istream& in) {
+    int version = 0;
+    std::string key;
+    // Read the format version first.
+    if (!(in >> key >> version) || key != "version" ||
+        version != ProfileVersion) {
+        throw std::runtime_error("Unsupported cost profile version");
+    }
+
+    // Read the coefficients as key-value pairs; every key appears once.
+    std::unordered_set<std::string> found;
+    while (in >> key) {
+        double value;
+        if (!(in >> value) || value < 0.0) {
+            throw std::runtime_error("Invalid value in cost profile: " + key);
+        }
+        if (key == "bfs_seq_step_ns") {
+            BfsSequentialStepNs_ = value;
+        } else if (key == "bfs_par_step_ns") {
+            BfsParallelStepNs_ = value;
+        } else if (key == "thread_spawn_ns") {
+            ThreadSpawnNs_ = value;
+        } else if (key == "floyd_relaxation_ns") {
+            FloydRelaxationNs_ = value;
+        } else if (key == "hardware_threads") {
+            if (value > std::numeric_limits<unsigned int>::max()) {
+                throw std::runtime_error("Invalid value in cost profile: " +
+                                         key);
+            }
+            HardwareThreads_ = std::max(1u, static_cast<unsigned int>(value));
+        } else {
+            throw std::runtime_error("Unknown key in cost profile: " + key);
+        }
+        if (!found.insert(key).second) {
+            throw std::runtime_error("Duplicate key in cost profile: " + key);
+        }
+    }
+    if (found.size() != 5) {
+        throw std::runtime_error("Incomplete cost profile");
+    }
+}
+
+void TCostModel::Save(std::ostream& out) const {
+    // Write enough digits for the coefficients to round-trip exactly.
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    out << "version " << ProfileVersion << "\n";
+    out << "hardware_threads " << HardwareThreads_ << "\n";
+    out << "bfs_seq_step_ns " << BfsSequentialStepNs_ << "\n";
+    out << "bfs_par_step_ns " << BfsParallelStepNs_ << "\n";
+    out << "thread_spawn_ns " << ThreadSpawnNs_ << "\n";
+    out << "floyd_relaxation_ns " << FloydRelaxationNs_ << "\n";
+}
+
+double TCostModel::Predict(EAlgorithm algorithm, const TGraphStatistics& stats,
+                           unsigned int numThreads) const noexcept {
+    double n = stats.Vertices;
+    double steps = stats.TraversalSteps();
+    double levels = stats.EstimatedDiameter + 1.0;
+    // Threads beyond the hardware concurrency add overhead but no speedup.
+    double threads = std::max(1u, numThreads);
+    double speedup = std::min(threads, static_cast<double>(HardwareThreads_));
+
+    switch (algorithm) {
+        case EAlgorithm::BfsSequential:
+            return BfsSequentialStepNs_ * steps;
+        case EAlgorithm::BfsParallel:
+            // Every level launches a fresh batch of threads.
+            return levels * threads * ThreadSpawnNs_ +
+                   BfsParallelStepNs_ * steps / speedup;
+        case EAlgorithm::FloydSequential:
+            return FloydRelaxationNs_ * n * n * n;
+        case EAlgorithm::FloydParallel:
+            // Every k iteration launches a fresh batch of threads.
+            return n * std::min(threads, n) * ThreadSpawnNs_ +
+                   FloydRelaxationNs_ * n * n * n / speedup;
+    }
+    return std::numeric_limits<double>::max();
+}
+
+}  // namespace NShortestPaths
@@ -9,7 +9,8 @@
 
 namespace NShortestPaths {
 
-std::vector<int> TFloydWarshall::Compute(const TGraph& graph, int start) const {
+std::vector<int> TFloydWarshall::DoCompute(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
     int n = graph.VerticesCount();
     // Validate the starting vertex.
     if (start < 0 || start >= n) {
@@ -35,11 +36,14 @@ std::vector<int> TFloydWarshall::Compute(const TGraph& graph, int start) const {
     }
 
     // Use the Floyd–Warshall algorithm to compute all pairs shortest paths.
-    for (int k = 0; k < n; ++k)
+    for (int k = 0; k < n; ++k) {
+        // Check for cancellation between k iterations.
+        token.ThrowIfCancelled();
         for (int i = 0; i < n; ++i)
             for (int j = 0; j < n; ++j)
                 if (dist[i][k] + dist[k][j] < dist[i][j])
                     dist[i][j] = dist[i][k] + dist[k][j];
+    }
 
     // Prepare the result vector for distances from the starting vertex.
     std::vector<int> result(n, -1);
@@ -11,8 +11,8 @@
 
 namespace NShortestPaths {
 
-std::vector<int> TFloydWarshallParallel::Compute(const TGraph &graph,
-                                                 int start) const {
+std::vector<int> TFloydWarshallParallel::DoCompute(
+    const TGraph &graph, int start, const TCancellationToken &token) const {
     int n = graph.VerticesCount();
     // Validate the starting vertex.
     if (start < 0 || start >= n) {
@@ -38,13 +38,18 @@ std::vector<int> TFloydWarshallParallel::Compute(const TGraph &graph,
     }
 
     // Determine the number of threads to use.
-    unsigned int numThreads = std::thread::hardware_concurrency();
+    unsigned int numThreads = NumThreads_;
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
     if (numThreads == 0) {
         numThreads = 2;
     }
 
     // Run the Floyd–Warshall algorithm with parallel inner loops.
     for (int k = 0; k < n; ++k) {
+        // Check for cancellation between k iterations.
+        token.ThrowIfCancelled();
         std::vector<std::thread> threads;
         int chunkSize = (n + numThreads - 1) / numThreads;
         for (unsigned int t = 0; t < numThreads; t++) {
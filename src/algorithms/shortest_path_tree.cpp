@@ -0,0 +1,42 @@
+#include "shortest_path_tree.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace NShortestPaths {
+
+std::vector<int> ExtractPath(const TShortestPathTree& tree, int target) {
+    // Validate the target vertex.
+    int n = static_cast<int>(tree.Distances.size());
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Invalid target vertex");
+    }
+    // Validate the shape of the tree.
+    if (tree.Parents.size() != tree.Distances.size()) {
+        throw std::invalid_argument("Tree has no predecessor for every vertex");
+    }
+    if (tree.Distances[target] == -1) {
+        return {};
+    }
+
+    // Walk the predecessors back to the starting vertex; a shortest path
+    // has exactly one vertex more than its length.
+    int length = tree.Distances[target] + 1;
+    std::vector<int> path;
+    path.reserve(length);
+    for (int v = target; v != -1; v = tree.Parents[v]) {
+        if (v < 0 || v >= n || static_cast<int>(path.size()) == length) {
+            throw std::invalid_argument("Malformed shortest path tree");
+        }
+        path.push_back(v);
+    }
+    if (static_cast<int>(path.size()) != length) {
+        throw std::invalid_argument("Malformed shortest path tree");
+    }
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+}  // namespace NShortestPaths
@@ -0,0 +1,34 @@
+#include "cached_shortest_path_finder.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace NShortestPaths {
+
+std::vector<int> TCachedShortestPathFinder::DoCompute(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    // Validate the starting vertex.
+    if (start < 0 || start >= graph.VerticesCount()) {
+        throw std::out_of_range("Invalid starting vertex");
+    }
+
+    TResultCache::TKey key{graph.Version(), Algorithm_, start};
+    if (auto cached = Cache_.Find(key)) {
+        return std::move(*cached);
+    }
+
+    // Results of the contents replaced by the last load can never be hit
+    // again. Only misses pay for dropping them, and shards without such
+    // results are skipped.
+    if (graph.PreviousVersion() != 0) {
+        Cache_.Invalidate(graph.PreviousVersion());
+    }
+    auto distances = Finder_.Compute(graph, start, token);
+    Cache_.Insert(key, distances);
+    return distances;
+}
+
+}  // namespace NShortestPaths
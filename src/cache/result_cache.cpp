@@ -0,0 +1,190 @@
+#include "result_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace NShortestPaths {
+
+namespace {
+
+// Estimate the memory occupied by a cache entry including its bookkeeping.
+std::size_t EntryBytes(const std::string& algorithm,
+                       const TCompactDistances& distances) noexcept {
+    return distances.Bytes() + algorithm.capacity() + 4 * sizeof(void*) +
+           sizeof(std::uint64_t) + sizeof(int);
+}
+
+}  // namespace
+
+TCompactDistances::TCompactDistances(const std::vector<int>& distances)
+    : Size_(distances.size()) {
+    // Pick the narrowest width for the largest shifted distance.
+    int maxDistance = -1;
+    for (auto d : distances) {
+        maxDistance = std::max(maxDistance, d);
+    }
+    auto maxValue = static_cast<std::uint32_t>(maxDistance + 1);
+    if (maxValue <= std::numeric_limits<std::uint8_t>::max()) {
+        Width_ = 1;
+    } else if (maxValue <= std::numeric_limits<std::uint16_t>::max()) {
+        Width_ = 2;
+    } else {
+        Width_ = 4;
+    }
+
+    Data_.resize(Size_ * Width_);
+    for (std::size_t i = 0; i < Size_; ++i) {
+        auto value = static_cast<std::uint32_t>(distances[i] + 1);
+        if (Width_ == 1) {
+            Data_[i] = static_cast<std::uint8_t>(value);
+        } else if (Width_ == 2) {
+            auto narrow = static_cast<std::uint16_t>(value);
+            std::memcpy(&Data_[i * 2], &narrow, sizeof(narrow));
+        } else {
+            std::memcpy(&Data_[i * 4], &value, sizeof(value));
+        }
+    }
+}
+
+std::vector<int> TCompactDistances::Decode() const {
+    std::vector<int> distances(Size_);
+    for (std::size_t i = 0; i < Size_; ++i) {
+        std::uint32_t value;
+        if (Width_ == 1) {
+            value = Data_[i];
+        } else if (Width_ == 2) {
+            std::uint16_t narrow;
+            std::memcpy(&narrow, &Data_[i * 2], sizeof(narrow));
+            value = narrow;
+        } else {
+            std::memcpy(&value, &Data_[i * 4], sizeof(value));
+        }
+        distances[i] = static_cast<int>(value) - 1;
+    }
+    return distances;
+}
+
+std::size_t TResultCache::TKeyHash::operator()(
+    const TKey& key) const noexcept {
+    // Combine the hashes of the fields.
+    std::size_t hash = std::hash<std::uint64_t>{}(key.GraphVersion);
+    hash ^= std::hash<std::string>{}(key.Algorithm) + 0x9e3779b97f4a7c15ULL +
+            (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>{}(key.Source) + 0x9e3779b97f4a7c15ULL +
+            (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+TResultCache::TResultCache(std::size_t budgetBytes, std::size_t shards)
+    : ShardBudget_(budgetBytes / std::max<std::size_t>(shards, 1)),
+      Shards_(std::max<std::size_t>(shards, 1)) {}
+
+TResultCache::TShard& TResultCache::ShardFor(const TKey& key) noexcept {
+    return Shards_[TKeyHash{}(key) % Shards_.size()];
+}
+
+std::list<TResultCache::TEntry>::iterator TResultCache::Erase(
+    TShard& shard, std::list<TEntry>::iterator it) {
+    shard.Bytes -= EntryBytes(it->Key.Algorithm, *it->Distances);
+    if (auto count = shard.Versions.find(it->Key.GraphVersion);
+        --count->second == 0) {
+        shard.Versions.erase(count);
+    }
+    shard.Index.erase(it->Key);
+    return shard.Entries.erase(it);
+}
+
+std::optional<std::vector<int>> TResultCache::Find(const TKey& key) {
+    auto& shard = ShardFor(key);
+    std::shared_ptr<const TCompactDistances> distances;
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        auto it = shard.Index.find(key);
+        if (it != shard.Index.end()) {
+            // Move the entry to the front of the recency list.
+            shard.Entries.splice(shard.Entries.begin(), shard.Entries,
+                                 it->second);
+            distances = it->second->Distances;
+        }
+    }
+
+    if (!distances) {
+        Misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    Hits_.fetch_add(1, std::memory_order_relaxed);
+    // Decode outside the lock so that readers of the shard do not wait.
+    return distances->Decode();
+}
+
+void TResultCache::Insert(const TKey& key, const std::vector<int>& distances) {
+    // Encode before taking the lock.
+    auto compact = std::make_shared<const TCompactDistances>(distances);
+    std::size_t bytes = EntryBytes(key.Algorithm, *compact);
+    if (bytes > ShardBudget_) {
+        return;
+    }
+
+    auto& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    // Replace a result stored concurrently by another query.
+    if (auto it = shard.Index.find(key); it != shard.Index.end()) {
+        Erase(shard, it->second);
+    }
+
+    // Evict the least recently used entries until the result fits.
+    while (shard.Bytes + bytes > ShardBudget_ && !shard.Entries.empty()) {
+        Erase(shard, std::prev(shard.Entries.end()));
+        Evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.Entries.push_front({key, std::move(compact)});
+    shard.Index.emplace(key, shard.Entries.begin());
+    ++shard.Versions[key.GraphVersion];
+    shard.Bytes += bytes;
+}
+
+void TResultCache::Invalidate(std::uint64_t graphVersion) {
+    for (auto& shard : Shards_) {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        if (!shard.Versions.contains(graphVersion)) {
+            continue;
+        }
+        for (auto it = shard.Entries.begin(); it != shard.Entries.end();) {
+            if (it->Key.GraphVersion == graphVersion) {
+                it = Erase(shard, it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void TResultCache::Clear() {
+    for (auto& shard : Shards_) {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        shard.Entries.clear();
+        shard.Index.clear();
+        shard.Versions.clear();
+        shard.Bytes = 0;
+    }
+}
+
+TResultCache::TStatistics TResultCache::Statistics() const {
+    TStatistics stats;
+    stats.Hits = Hits_.load(std::memory_order_relaxed);
+    stats.Misses = Misses_.load(std::memory_order_relaxed);
+    stats.Evictions = Evictions_.load(std::memory_order_relaxed);
+    for (const auto& shard : Shards_) {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        stats.Entries += shard.Entries.size();
+        stats.Bytes += shard.Bytes;
+    }
+    return stats;
+}
+
+}  // namespace NShortestPaths
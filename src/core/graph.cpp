@@ -1,10 +1,23 @@
 #include "graph.hpp"
 
+#include <atomic>
 #include <stdexcept>
 
 namespace NShortestPaths {
 
+namespace {
+
+// Source of graph versions shared by all graphs.
+std::atomic<std::uint64_t> NextVersion{1};
+
+}  // namespace
+
 void TGraph::Load(std::istream& in) {
+    // Give the new contents a fresh version before changing them so that
+    // cached results become stale even if loading fails.
+    PreviousVersion_ = Version_;
+    Version_ = NextVersion.fetch_add(1, std::memory_order_relaxed);
+
     // Read the number of vertices.
     if (!(in >> VerticesCount_)) {
         throw std::runtime_error("Failed to read number of vertices");
@@ -31,6 +44,9 @@ void TGraph::Load(std::istream& in) {
         AdjList_[u].push_back(v);
         AdjList_[v].push_back(u);
     }
+
+    // Collect the statistics once so that finders can consult them cheaply.
+    Statistics_ = CollectStatistics(AdjList_);
 }
 
 }  // namespace NShortestPaths
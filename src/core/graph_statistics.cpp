@@ -0,0 +1,93 @@
+#include "graph_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace NShortestPaths {
+
+namespace {
+
+// Run a BFS from the given vertex over the vertices whose distance is still
+// -1 and return the farthest reached vertex together with its distance. The
+// visited vertices are left in the queue.
+std::pair<int, int> FarthestVertex(std::span<const std::vector<int>> adjacency,
+                                   int start, std::vector<int>& distances,
+                                   std::vector<int>& queue) {
+    queue.clear();
+    distances[start] = 0;
+    queue.push_back(start);
+
+    int farthest = start;
+    // The vector doubles as a queue since every vertex is pushed only once.
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        if (distances[u] > distances[farthest]) {
+            farthest = u;
+        }
+        for (auto v : adjacency[u]) {
+            if (distances[v] == -1) {
+                distances[v] = distances[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    return {farthest, distances[farthest]};
+}
+
+}  // namespace
+
+TGraphStatistics CollectStatistics(
+    std::span<const std::vector<int>> adjacency) {
+    TGraphStatistics stats;
+    stats.Vertices = static_cast<int>(adjacency.size());
+    if (stats.Vertices == 0) {
+        return stats;
+    }
+
+    // Gather the degree distribution in a single pass.
+    long long degreeSum = 0;
+    double degreeSquareSum = 0.0;
+    stats.MinDegree = static_cast<int>(adjacency[0].size());
+    for (int u = 0; u < stats.Vertices; ++u) {
+        int degree = static_cast<int>(adjacency[u].size());
+        degreeSum += degree;
+        degreeSquareSum += static_cast<double>(degree) * degree;
+        stats.MinDegree = std::min(stats.MinDegree, degree);
+        stats.MaxDegree = std::max(stats.MaxDegree, degree);
+        if (degree == 0) {
+            ++stats.IsolatedVertices;
+        }
+    }
+    stats.Edges = degreeSum / 2;
+    stats.AverageDegree = static_cast<double>(degreeSum) / stats.Vertices;
+    double variance = degreeSquareSum / stats.Vertices -
+                      stats.AverageDegree * stats.AverageDegree;
+    stats.DegreeStdDev = std::sqrt(std::max(variance, 0.0));
+
+    // Double sweep in every component: the farthest vertex from any vertex
+    // is a good starting point for a second BFS whose eccentricity bounds
+    // the diameter of the component from below. The first sweeps also mark
+    // the components, so both sweeps visit every vertex once in total.
+    std::vector<int> component(stats.Vertices, -1);
+    std::vector<int> distances(stats.Vertices, -1);
+    std::vector<int> queue;
+    queue.reserve(stats.Vertices);
+    for (int u = 0; u < stats.Vertices; ++u) {
+        if (component[u] != -1 || adjacency[u].empty()) {
+            continue;
+        }
+        auto [peripheral, firstDepth] =
+            FarthestVertex(adjacency, u, component, queue);
+        int secondDepth =
+            FarthestVertex(adjacency, peripheral, distances, queue).second;
+        stats.EstimatedDiameter =
+            std::max({stats.EstimatedDiameter, firstDepth, secondDepth});
+    }
+
+    return stats;
+}
+
+}  // namespace NShortestPaths
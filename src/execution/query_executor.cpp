@@ -0,0 +1,128 @@
+#include "query_executor.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace NShortestPaths {
+
+TQueryExecutor::TQueryExecutor(unsigned int numThreads) {
+    // Determine the number of threads to use.
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    // At least two workers are needed so that one stays free for point
+    // queries while bulk jobs run.
+    numThreads = std::max(2u, numThreads);
+    MaxRunningBulk_ = numThreads - 1;
+
+    Workers_.reserve(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        Workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+TQueryExecutor::~TQueryExecutor() {
+    std::deque<TTask> pending;
+    {
+        std::lock_guard<std::mutex> lock(Mutex_);
+        Stopping_ = true;
+        pending = std::move(PointQueue_);
+        for (auto& task : BulkQueue_) {
+            pending.push_back(std::move(task));
+        }
+        BulkQueue_.clear();
+        // Interrupt the running queries instead of waiting for them.
+        for (auto& stop : Running_) {
+            stop.request_stop();
+        }
+    }
+    Ready_.notify_all();
+
+    // Fail the queries that never started.
+    for (auto& task : pending) {
+        task.Promise.set_exception(std::make_exception_ptr(
+            TQueryCancelledError("Query executor shut down")));
+    }
+
+    // Join all threads.
+    for (auto& th : Workers_) {
+        th.join();
+    }
+}
+
+TQueryHandle TQueryExecutor::Submit(const IShortestPathFinder& finder,
+                                    const TGraph& graph, int start,
+                                    TQueryOptions options) {
+    std::stop_source stop;
+    TTask task{&finder,
+               &graph,
+               start,
+               options.Priority,
+               TCancellationToken(stop.get_token(), options.Deadline),
+               stop,
+               {}};
+    auto result = task.Promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(Mutex_);
+        if (Stopping_) {
+            throw TQueryCancelledError("Query executor shut down");
+        }
+        auto& queue = options.Priority == EQueryPriority::Point ? PointQueue_
+                                                                : BulkQueue_;
+        queue.push_back(std::move(task));
+    }
+    Ready_.notify_one();
+
+    return TQueryHandle(std::move(result), std::move(stop));
+}
+
+void TQueryExecutor::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(Mutex_);
+    while (true) {
+        // Point queries are always eligible, bulk ones only while a worker
+        // stays free for point queries.
+        Ready_.wait(lock, [this] {
+            return Stopping_ || !PointQueue_.empty() ||
+                   (!BulkQueue_.empty() && RunningBulk_ < MaxRunningBulk_);
+        });
+        if (Stopping_) {
+            return;
+        }
+
+        auto& queue = !PointQueue_.empty() ? PointQueue_ : BulkQueue_;
+        TTask task = std::move(queue.front());
+        queue.pop_front();
+        bool bulk = task.Priority == EQueryPriority::Bulk;
+        if (bulk) {
+            ++RunningBulk_;
+        }
+        // Register the query so that shutdown can interrupt it.
+        auto running = Running_.insert(Running_.end(), task.Stop);
+
+        lock.unlock();
+        Run(task);
+        lock.lock();
+
+        Running_.erase(running);
+        if (bulk) {
+            --RunningBulk_;
+            // A bulk slot became free, so a waiting worker may take a job.
+            Ready_.notify_one();
+        }
+    }
+}
+
+void TQueryExecutor::Run(TTask& task) {
+    try {
+        // Skip queries cancelled or expired while waiting in the queue.
+        task.Token.ThrowIfCancelled();
+        task.Promise.set_value(
+            task.Finder->Compute(*task.Graph, task.Start, task.Token));
+    } catch (...) {
+        task.Promise.set_exception(std::current_exception());
+    }
+}
+
+}  // namespace NShortestPaths
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <exception>
 #include <filesystem>
 #include <fstream>
@@ -6,11 +7,14 @@
 #include <string>
 #include <vector>
 
+#include "automatic_shortest_path_finder.hpp"
 #include "breadth_first_search.hpp"
 #include "breadth_first_search_parallel.hpp"
+#include "cost_model.hpp"
 #include "floyd_warshall.hpp"
 #include "floyd_warshall_parallel.hpp"
 #include "graph.hpp"
+#include "partitioned_breadth_first_search.hpp"
 #include "shortest_path_finder.hpp"
 
 using namespace NShortestPaths;
@@ -18,8 +22,23 @@ using namespace NShortestPaths;
 // Prints usage information.
 void PrintUsage(const char* progName) {
     std::print(stderr, "Usage: {} <graph_file> [algorithm]\n", progName);
-    std::print(stderr,
-               "  algorithm: bfs-seq, bfs-par, floyd-seq, or floyd-par\n");
+    std::print(
+        stderr,
+        "  algorithm: bfs-seq, bfs-par, bfs-part, floyd-seq, floyd-par, or "
+        "auto\n");
+}
+
+// Returns the location of the calibration profile used by the auto mode.
+std::filesystem::path ProfilePath() {
+    // An explicit location takes precedence.
+    if (const char* path = std::getenv("SHORTEST_PATHS_PROFILE")) {
+        return path;
+    }
+    // Otherwise keep the profile in the home directory of the user.
+    if (const char* home = std::getenv("HOME")) {
+        return std::filesystem::path(home) / ".shortest_paths_profile";
+    }
+    return ".shortest_paths_profile";
 }
 
 int main(int argc, char* argv[]) {
@@ -68,12 +87,19 @@ int main(int argc, char* argv[]) {
     } else if (algoStr == "bfs-par") {
         // Use parallel BFS algorithm.
         algorithm = std::make_unique<TBreadthFirstSearchParallel>();
+    } else if (algoStr == "bfs-part") {
+        // Use partitioned multi-process BFS algorithm.
+        algorithm = std::make_unique<TPartitionedBreadthFirstSearch>();
     } else if (algoStr == "floyd-seq") {
         // Use sequential Floyd–Warshall algorithm.
         algorithm = std::make_unique<TFloydWarshall>();
     } else if (algoStr == "floyd-par") {
         // Use parallel Floyd–Warshall algorithm.
         algorithm = std::make_unique<TFloydWarshallParallel>();
+    } else if (algoStr == "auto") {
+        // Pick the algorithm using the calibrated cost model.
+        algorithm = std::make_unique<TAutomaticShortestPathFinder>(
+            TCostModel::LoadOrCalibrate(ProfilePath()), true);
     } else {
         std::print(stderr, "Unknown algorithm: {}\n", algoStr);
         PrintUsage(argv[0]);
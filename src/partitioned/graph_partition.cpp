@@ -0,0 +1,63 @@
+#include "graph_partition.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace NShortestPaths {
+
+namespace {
+
+// Get the number of vertices per partition.
+int ChunkSize(const TGraph& graph, int parts) {
+    // Validate the number of partitions.
+    if (parts <= 0) {
+        throw std::invalid_argument("Number of partitions must be positive");
+    }
+    return std::max(1, (graph.VerticesCount() + parts - 1) / parts);
+}
+
+}  // namespace
+
+TGraphPartition TGraphPartition::Build(const TGraph& graph, int parts,
+                                       int index) {
+    int n = graph.VerticesCount();
+    int chunkSize = ChunkSize(graph, parts);
+    // Validate the partition index.
+    if (index < 0 || index >= parts) {
+        throw std::out_of_range("Invalid partition index");
+    }
+
+    TGraphPartition partition;
+    partition.ChunkSize_ = chunkSize;
+    partition.Begin_ = std::min(n, index * chunkSize);
+    partition.End_ = std::min(n, partition.Begin_ + chunkSize);
+    partition.Adjacency_ = graph.AdjacencyList();
+    return partition;
+}
+
+std::vector<std::vector<int>> TGraphPartition::BoundaryTargets(
+    const TGraph& graph, int parts) {
+    int n = graph.VerticesCount();
+    int chunkSize = ChunkSize(graph, parts);
+    const auto adj = graph.AdjacencyList();
+
+    // Partitions are scanned in order, so remembering the last partition
+    // that counted a vertex is enough to count it once per partition.
+    std::vector<std::vector<int>> counts(parts, std::vector<int>(parts, 0));
+    std::vector<int> countedBy(n, -1);
+    for (int u = 0; u < n; ++u) {
+        int p = u / chunkSize;
+        for (auto v : adj[u]) {
+            int owner = v / chunkSize;
+            if (owner != p && countedBy[v] != p) {
+                countedBy[v] = p;
+                ++counts[p][owner];
+            }
+        }
+    }
+
+    return counts;
+}
+
+}  // namespace NShortestPaths
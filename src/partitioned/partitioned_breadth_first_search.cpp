@@ -0,0 +1,525 @@
+#include "partitioned_breadth_first_search.hpp"
+
+#include <linux/futex.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_partition.hpp"
+#include "shared_region.hpp"
+
+namespace NShortestPaths {
+
+namespace {
+
+// Size of a cache line used to keep shared structures apart.
+constexpr std::size_t CacheLine = 64;
+// Number of polls of a barrier before sleeping on the futex.
+constexpr int SpinIterations = 100;
+// Period after which a sleeping coordinator checks that workers are alive.
+constexpr auto LivenessPeriod = std::chrono::milliseconds(10);
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int) &&
+                  std::atomic<int>::is_always_lock_free,
+              "Futexes require plain lock-free integers");
+
+// The ECommand enumeration lists the decisions of the coordinator after a
+// level.
+enum class ECommand {
+    Continue,
+    Done,
+    Cancel,
+};
+
+static_assert(std::atomic<ECommand>::is_always_lock_free,
+              "Atomics shared between processes must be lock-free");
+
+// The TControl structure holds the barrier and the coordinator decision.
+struct alignas(CacheLine) TControl {
+    // Number of processes that reached the barrier.
+    std::atomic<int> Waiting;
+    // Barrier generation, also used as the futex word.
+    std::atomic<int> Generation;
+    // Decision of the coordinator for the current level.
+    std::atomic<ECommand> Command;
+};
+
+// The TWorkerCounters structure holds what a worker reports after a level.
+struct alignas(CacheLine) TWorkerCounters {
+    // Size of the next frontier of the partition.
+    long long Next;
+    // Number of vertices sent to other partitions.
+    long long Messages;
+    // Number of batches sent to other partitions.
+    long long Batches;
+};
+
+// The TRingHeader structure holds the positions of a single-producer
+// single-consumer ring buffer.
+struct alignas(CacheLine) TRingHeader {
+    // Position of the next element to read, advanced by the consumer.
+    std::atomic<std::uint64_t> Head;
+    // Position of the next element to write, advanced by the producer.
+    alignas(CacheLine) std::atomic<std::uint64_t> Tail;
+    // Number of elements the ring can hold.
+    std::uint64_t Capacity;
+    // Offset of the ring storage in the shared data array.
+    std::uint64_t Offset;
+};
+
+// Sleep until the futex word no longer holds the expected value.
+void FutexWait(std::atomic<int>& word, int expected) {
+    auto ns = std::chrono::nanoseconds(LivenessPeriod).count();
+    timespec timeout{0, static_cast<long>(ns)};
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT, expected,
+            &timeout, nullptr, 0);
+}
+
+// Wake every process sleeping on the futex word.
+void FutexWakeAll(std::atomic<int>& word) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE, INT_MAX,
+            nullptr, nullptr, 0);
+}
+
+// The TProcessBarrier class synchronizes the coordinator and the workers
+// through the shared control block.
+class TProcessBarrier {
+   public:
+    TProcessBarrier(TControl& control, int participants) noexcept
+        : Control_(control), Participants_(participants) {}
+
+    // Wait for all participants, calling idle() whenever the wait sleeps and
+    // the barrier is still closed afterwards.
+    template <typename TIdle>
+    void Wait(TIdle&& idle) {
+        int generation = Control_.Generation.load(std::memory_order_acquire);
+        if (Control_.Waiting.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+            Participants_) {
+            // The last participant opens the barrier.
+            Control_.Waiting.store(0, std::memory_order_relaxed);
+            Control_.Generation.fetch_add(1, std::memory_order_acq_rel);
+            FutexWakeAll(Control_.Generation);
+            return;
+        }
+
+        for (int spin = 0; Control_.Generation.load(
+                               std::memory_order_acquire) == generation;
+             ++spin) {
+            if (spin < SpinIterations) {
+                std::this_thread::yield();
+                continue;
+            }
+            FutexWait(Control_.Generation, generation);
+            // Once the barrier opens, workers may exit before we look at
+            // them, so only a closed barrier is worth checking on.
+            if (Control_.Generation.load(std::memory_order_acquire) ==
+                generation) {
+                idle();
+            }
+        }
+    }
+
+    // Wait for all participants.
+    void Wait() { Wait([] {}); }
+
+   private:
+    TControl& Control_;
+    int Participants_;
+};
+
+// The TRing class gives access to a ring buffer carrying batches of vertices
+// from one partition to another.
+class TRing {
+   public:
+    TRing(TRingHeader& header, int* data) noexcept
+        : Header_(header), Data_(data + header.Offset) {}
+
+    // Publish a batch of at most BatchSize vertices.
+    void Push(std::span<const int> batch) {
+        auto tail = Header_.Tail.load(std::memory_order_relaxed);
+        auto head = Header_.Head.load(std::memory_order_acquire);
+        if (Header_.Capacity - (tail - head) < batch.size() + 1) {
+            throw std::length_error("Ring buffer overflow");
+        }
+        // Every batch is prefixed with its length.
+        Data_[tail % Header_.Capacity] = static_cast<int>(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            Data_[(tail + 1 + i) % Header_.Capacity] = batch[i];
+        }
+        Header_.Tail.store(tail + batch.size() + 1, std::memory_order_release);
+    }
+
+    // Consume every published vertex.
+    template <typename TConsumer>
+    void Drain(TConsumer&& consume) {
+        auto head = Header_.Head.load(std::memory_order_relaxed);
+        auto tail = Header_.Tail.load(std::memory_order_acquire);
+        while (head != tail) {
+            int count = Data_[head++ % Header_.Capacity];
+            for (int i = 0; i < count; ++i) {
+                consume(Data_[head++ % Header_.Capacity]);
+            }
+        }
+        Header_.Head.store(head, std::memory_order_release);
+    }
+
+   private:
+    TRingHeader& Header_;
+    int* Data_;
+};
+
+// The TSharedState structure locates the shared structures inside the region.
+struct TSharedState {
+    // Barrier and coordinator decision.
+    TControl* Control;
+    // Counters reported by every worker.
+    TWorkerCounters* Counters;
+    // Ring headers indexed by sender * partitions + receiver.
+    TRingHeader* Rings;
+    // Distances, each range written only by its owner.
+    int* Distances;
+    // Storage of all rings.
+    int* RingData;
+    // Number of partitions.
+    int Partitions;
+
+    // Get the ring from one partition to another.
+    [[nodiscard]] TRing Ring(int from, int to) const noexcept {
+        return TRing(Rings[from * Partitions + to], RingData);
+    }
+};
+
+// Round the offset up to a multiple of the cache line.
+std::size_t AlignUp(std::size_t offset) noexcept {
+    return (offset + CacheLine - 1) / CacheLine * CacheLine;
+}
+
+// Pin the calling process to one of the CPUs it may run on, spreading the
+// workers so that the pages each one touches first are allocated on the
+// NUMA node of its own CPU.
+void PinWorker(int p) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    int target = p % std::max(1, CPU_COUNT(&allowed));
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+            cpu_set_t single;
+            CPU_ZERO(&single);
+            CPU_SET(cpu, &single);
+            // Pinning only affects locality, so a failure is ignored.
+            sched_setaffinity(0, sizeof(single), &single);
+            return;
+        }
+    }
+}
+
+// Run the BFS of one partition inside a worker process.
+void RunWorker(int p, const TGraph& graph, const TSharedState& shared,
+               int start) {
+    PinWorker(p);
+    // The partition reads the adjacency the coordinator already holds, so
+    // the graph is shared with the workers instead of copied.
+    auto partition = TGraphPartition::Build(graph, shared.Partitions, p);
+    TProcessBarrier barrier(*shared.Control, shared.Partitions + 1);
+    int* distances = shared.Distances;
+
+    // Only the owner ever touches its range of distances, so it initializes
+    // them itself and their pages land on its node.
+    std::fill(distances + partition.Begin(), distances + partition.End(), -1);
+
+    std::vector<int> frontier;
+    std::vector<int> next;
+    std::vector<std::vector<int>> outgoing(shared.Partitions);
+    if (partition.Owns(start)) {
+        distances[start] = 0;
+        frontier.push_back(start);
+    }
+
+    for (int level = 0;; ++level) {
+        // Expand the frontier, visiting owned vertices directly and
+        // collecting the boundary ones for their owners.
+        for (auto u : frontier) {
+            for (auto v : partition.Neighbors(u)) {
+                if (partition.Owns(v)) {
+                    if (distances[v] == -1) {
+                        distances[v] = level + 1;
+                        next.push_back(v);
+                    }
+                } else {
+                    outgoing[partition.Owner(v)].push_back(v);
+                }
+            }
+        }
+
+        // Send the deduplicated boundary vertices in batches.
+        constexpr size_t batchSize = TPartitionedBreadthFirstSearch::BatchSize;
+        long long messages = 0, batches = 0;
+        for (int q = 0; q < shared.Partitions; ++q) {
+            auto& out = outgoing[q];
+            if (out.empty()) continue;
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+            auto ring = shared.Ring(p, q);
+            for (size_t i = 0; i < out.size(); i += batchSize) {
+                size_t count = std::min(batchSize, out.size() - i);
+                ring.Push(std::span<const int>(out).subspan(i, count));
+                ++batches;
+            }
+            messages += static_cast<long long>(out.size());
+            out.clear();
+        }
+        barrier.Wait();
+
+        // Receive the vertices discovered by other partitions.
+        for (int q = 0; q < shared.Partitions; ++q) {
+            if (q == p) continue;
+            shared.Ring(q, p).Drain([&](int v) {
+                if (distances[v] == -1) {
+                    distances[v] = level + 1;
+                    next.push_back(v);
+                }
+            });
+        }
+        shared.Counters[p] = {static_cast<long long>(next.size()), messages,
+                              batches};
+        barrier.Wait();
+
+        // Wait for the decision of the coordinator.
+        barrier.Wait();
+        if (shared.Control->Command.load(std::memory_order_relaxed) !=
+            ECommand::Continue) {
+            break;
+        }
+        frontier.swap(next);
+        next.clear();
+    }
+}
+
+// The TWorkerGroup class owns the forked worker processes and kills the ones
+// still running when it is destroyed.
+class TWorkerGroup {
+   public:
+    TWorkerGroup() = default;
+    ~TWorkerGroup() {
+        for (auto pid : Pids_) {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+
+    TWorkerGroup(const TWorkerGroup&) = delete;
+    TWorkerGroup& operator=(const TWorkerGroup&) = delete;
+
+    // Fork a worker process running the function.
+    template <typename TFunc>
+    void Spawn(TFunc&& func) {
+        pid_t parent = getpid();
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to fork worker process");
+        }
+        if (pid == 0) {
+            // Die together with the coordinator.
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != parent) {
+                _exit(1);
+            }
+            int status = 0;
+            try {
+                func();
+            } catch (...) {
+                status = 1;
+            }
+            // Skip the destructors and atexit handlers of the parent.
+            _exit(status);
+        }
+        Pids_.push_back(pid);
+    }
+
+    // Throw if a worker exited before being told to. Once the final command
+    // is published, a clean exit is expected and only forgets the worker.
+    // Workers that can no longer be waited for are forgotten so that their
+    // pids, which may be reused, are never signalled.
+    void CheckAlive(bool finished) {
+        for (size_t i = 0; i < Pids_.size();) {
+            int status = 0;
+            pid_t result = waitpid(Pids_[i], &status, WNOHANG);
+            int error = result < 0 ? errno : 0;
+            if (result == 0 || error == EINTR) {
+                ++i;
+                continue;
+            }
+            Pids_.erase(Pids_.begin() + i);
+            if (result > 0 && finished && WIFEXITED(status) &&
+                WEXITSTATUS(status) == 0) {
+                continue;
+            }
+            if (error == ECHILD) {
+                throw std::runtime_error("Worker process is no longer a child");
+            }
+            throw std::runtime_error("Worker process exited unexpectedly");
+        }
+    }
+
+    // Wait for all workers and throw if any of them failed.
+    void Join() {
+        bool failed = false;
+        while (!Pids_.empty()) {
+            int status = 0;
+            pid_t result = waitpid(Pids_.back(), &status, 0);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result < 0 || !WIFEXITED(status) ||
+                WEXITSTATUS(status) != 0) {
+                failed = true;
+            }
+            Pids_.pop_back();
+        }
+        if (failed) {
+            throw std::runtime_error("Worker process failed");
+        }
+    }
+
+   private:
+    // Workers not yet reaped.
+    std::vector<pid_t> Pids_;
+};
+
+}  // namespace
+
+std::vector<int> TPartitionedBreadthFirstSearch::DoCompute(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    return ComputeWithStats(graph, start, token).Distances;
+}
+
+TPartitionedBfsResult TPartitionedBreadthFirstSearch::ComputeWithStats(
+    const TGraph& graph, int start, const TCancellationToken& token) const {
+    int n = graph.VerticesCount();
+    // Validate the starting vertex.
+    if (start < 0 || start >= n) {
+        throw std::out_of_range("Invalid starting vertex");
+    }
+
+    // Determine the number of worker processes to use.
+    int parts = NumPartitions_;
+    if (parts <= 0) {
+        parts = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    parts = std::clamp(parts, 1, n);
+    // Size the rings from the boundary vertices between every pair.
+    auto boundary = TGraphPartition::BoundaryTargets(graph, parts);
+
+    // Lay out the control block, the counters, the ring headers, the
+    // distances and the ring storage in one shared region. Every ring holds
+    // all boundary vertices of a level plus the batch headers.
+    std::size_t countersOffset = AlignUp(sizeof(TControl));
+    std::size_t ringsOffset =
+        AlignUp(countersOffset + parts * sizeof(TWorkerCounters));
+    std::size_t distancesOffset =
+        AlignUp(ringsOffset + parts * parts * sizeof(TRingHeader));
+    std::size_t ringDataOffset = AlignUp(distancesOffset + n * sizeof(int));
+    std::vector<std::uint64_t> capacities(parts * parts, 0);
+    std::uint64_t ringDataSize = 0;
+    for (int p = 0; p < parts; ++p) {
+        for (int q = 0; q < parts; ++q) {
+            std::uint64_t targets = boundary[p][q];
+            capacities[p * parts + q] =
+                targets + (targets + BatchSize - 1) / BatchSize;
+            ringDataSize += capacities[p * parts + q];
+        }
+    }
+    TSharedRegion region(ringDataOffset + ringDataSize * sizeof(int));
+
+    TSharedState shared;
+    std::byte* base = region.Data();
+    shared.Control = std::construct_at(reinterpret_cast<TControl*>(base));
+    shared.Counters = reinterpret_cast<TWorkerCounters*>(base + countersOffset);
+    for (int p = 0; p < parts; ++p) {
+        std::construct_at(&shared.Counters[p]);
+    }
+    shared.Rings = reinterpret_cast<TRingHeader*>(base + ringsOffset);
+    std::uint64_t ringOffset = 0;
+    for (int i = 0; i < parts * parts; ++i) {
+        std::construct_at(&shared.Rings[i]);
+        shared.Rings[i].Capacity = capacities[i];
+        shared.Rings[i].Offset = ringOffset;
+        ringOffset += capacities[i];
+    }
+    // The distances are initialized by the workers owning them.
+    shared.Distances = reinterpret_cast<int*>(base + distancesOffset);
+    shared.RingData = reinterpret_cast<int*>(base + ringDataOffset);
+    shared.Partitions = parts;
+
+    // Fork one worker per partition.
+    TWorkerGroup workers;
+    for (int p = 0; p < parts; ++p) {
+        workers.Spawn([&, p] { RunWorker(p, graph, shared, start); });
+    }
+
+    // Coordinate the levels until no partition has a frontier.
+    TPartitionedBfsResult result;
+    TProcessBarrier barrier(*shared.Control, parts + 1);
+    long long frontier = 1;
+    auto command = ECommand::Continue;
+    auto checkAlive = [&] {
+        workers.CheckAlive(command != ECommand::Continue);
+    };
+    while (command == ECommand::Continue) {
+        // Wait for the expansion and the exchange of the level.
+        barrier.Wait(checkAlive);
+        barrier.Wait(checkAlive);
+
+        TPartitionedLevelStats level;
+        level.Frontier = frontier;
+        long long next = 0;
+        for (int p = 0; p < parts; ++p) {
+            next += shared.Counters[p].Next;
+            level.Messages += shared.Counters[p].Messages;
+            level.Batches += shared.Counters[p].Batches;
+        }
+        level.Bytes = (level.Messages + level.Batches) * sizeof(int);
+        result.Levels.push_back(level);
+        frontier = next;
+
+        // Check for cancellation between levels.
+        if (next == 0) {
+            command = ECommand::Done;
+        } else if (token.IsCancelled()) {
+            command = ECommand::Cancel;
+        }
+        shared.Control->Command.store(command, std::memory_order_relaxed);
+        barrier.Wait(checkAlive);
+    }
+    workers.Join();
+    if (command == ECommand::Cancel) {
+        token.ThrowIfCancelled();
+    }
+
+    result.Distances.assign(shared.Distances, shared.Distances + n);
+    return result;
+}
+
+}  // namespace NShortestPaths
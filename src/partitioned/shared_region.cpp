@@ -0,0 +1,23 @@
+#include "shared_region.hpp"
+
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace NShortestPaths {
+
+TSharedRegion::TSharedRegion(std::size_t size) : Size_(size) {
+    // Anonymous shared mappings are zero-filled and inherited by fork().
+    void* data = mmap(nullptr, Size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to map shared memory");
+    }
+    Data_ = static_cast<std::byte*>(data);
+}
+
+TSharedRegion::~TSharedRegion() { munmap(Data_, Size_); }
+
+}  // namespace NShortestPaths
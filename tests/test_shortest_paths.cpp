@@ -1,19 +1,57 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <exception>
 #include <print>
 #include <sstream>
+#include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "automatic_shortest_path_finder.hpp"
 #include "breadth_first_search.hpp"
 #include "breadth_first_search_parallel.hpp"
+#include "cached_shortest_path_finder.hpp"
+#include "cost_model.hpp"
 #include "floyd_warshall.hpp"
 #include "floyd_warshall_parallel.hpp"
 #include "graph.hpp"
 #include "graph_factory.hpp"
+#include "partitioned_breadth_first_search.hpp"
+#include "query_executor.hpp"
+#include "result_cache.hpp"
+#include "shortest_path_tree.hpp"
 
 using namespace NShortestPaths;
 
+// Checks that the tree holds the expected distances and that every extracted
+// path is a shortest path in the graph.
+void checkTree(const TGraph& graph, [[maybe_unused]] int start,
+               const TShortestPathTree& tree,
+               const std::vector<int>& expected) {
+    assert(tree.Distances == expected);
+    assert(tree.Parents.size() == expected.size());
+    assert(tree.Parents[start] == -1);
+
+    const auto adj = graph.AdjacencyList();
+    for (int v = 0; v < graph.VerticesCount(); ++v) {
+        auto path = ExtractPath(tree, v);
+        if (expected[v] == -1) {
+            assert(path.empty() && tree.Parents[v] == -1);
+            continue;
+        }
+        assert(static_cast<int>(path.size()) == expected[v] + 1);
+        assert(path.front() == start && path.back() == v);
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            [[maybe_unused]] const auto& neighbors = adj[path[i]];
+            assert(std::find(neighbors.begin(), neighbors.end(),
+                             path[i + 1]) != neighbors.end());
+        }
+    }
+}
+
 // Runs a test for a randomly generated tree of size n.
 void runTest(int n) {
     // Generate a random tree.
@@ -37,17 +75,353 @@ void runTest(int n) {
     TBreadthFirstSearchParallel bfs_par;
     TFloydWarshall floyd_seq;
     TFloydWarshallParallel floyd_par;
+    TAutomaticShortestPathFinder automatic{TCostModel()};
+    TPartitionedBreadthFirstSearch bfs_part(3);
 
     // Compute distances using both sequential and parallel algorithms.
     auto bfsResultSeq = bfs_seq.Compute(graph, startVertex);
     auto bfsResultPar = bfs_par.Compute(graph, startVertex);
     auto floydResultSeq = floyd_seq.Compute(graph, startVertex);
     auto floydResultPar = floyd_par.Compute(graph, startVertex);
+    auto automaticResult = automatic.Compute(graph, startVertex);
+    auto bfsResultPart = bfs_part.Compute(graph, startVertex);
 
     // Assert that all algorithms produce the same result.
     assert(bfsResultSeq == bfsResultPar);
     assert(bfsResultSeq == floydResultSeq);
     assert(bfsResultSeq == floydResultPar);
+    assert(bfsResultSeq == automaticResult);
+    assert(bfsResultSeq == bfsResultPart);
+
+    // The predecessor trees agree with the distances.
+    checkTree(graph, startVertex, bfs_seq.ComputeTree(graph, startVertex),
+              bfsResultSeq);
+    checkTree(graph, startVertex, bfs_par.ComputeTree(graph, startVertex),
+              bfsResultSeq);
+}
+
+// Checks the statistics collected for a path graph.
+void testStatistics() {
+    // A path of 10 vertices has 9 edges and diameter 9.
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i + 1 < 10; ++i) {
+        edges.push_back({i, i + 1});
+    }
+    std::istringstream iss(NGraphFactory::SerializeGraph(10, edges));
+    TGraph graph;
+    graph.Load(iss);
+
+    [[maybe_unused]] const auto& stats = graph.Statistics();
+    assert(stats.Vertices == 10);
+    assert(stats.Edges == 9);
+    assert(stats.MinDegree == 1);
+    assert(stats.MaxDegree == 2);
+    assert(stats.IsolatedVertices == 0);
+    assert(stats.EstimatedDiameter == 9);
+}
+
+// Checks that a deep component without the hub drives the diameter estimate
+// and keeps the automatic finder away from the parallel BFS.
+void testDisconnectedStatistics() {
+    // A star with 3 leaves around vertex 0 and a path over the other ones.
+    constexpr int n = 2000;
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {0, 2}, {0, 3}};
+    for (int i = 4; i + 1 < n; ++i) {
+        edges.push_back({i, i + 1});
+    }
+    std::istringstream iss(NGraphFactory::SerializeGraph(n, edges));
+    TGraph graph;
+    graph.Load(iss);
+
+    [[maybe_unused]] const auto& stats = graph.Statistics();
+    assert(stats.MaxDegree == 3);
+    assert(stats.EstimatedDiameter == n - 5);
+
+    // Even with many threads a deep graph pays a spawn per level.
+    std::istringstream profile(
+        "version 1\nhardware_threads 8\nbfs_seq_step_ns 5\n"
+        "bfs_par_step_ns 20\nthread_spawn_ns 20000\n"
+        "floyd_relaxation_ns 1\n");
+    TCostModel model;
+    model.Load(profile);
+    [[maybe_unused]] TAutomaticShortestPathFinder automatic{model};
+    assert(automatic.Select(stats).Algorithm == EAlgorithm::BfsSequential);
+}
+
+// Checks that the cost model survives a round trip through a profile and
+// rejects malformed profiles.
+void testCostModelProfile() {
+    TCostModel model;
+    std::stringstream profile;
+    model.Save(profile);
+
+    TCostModel loaded;
+    loaded.Load(profile);
+    assert(loaded.HardwareThreads() == model.HardwareThreads());
+
+    // Predictions must be identical for the same statistics.
+    TGraphStatistics stats{1000, 999, 1, 10, 2.0, 1.0, 0, 30};
+    for ([[maybe_unused]] auto algorithm :
+         {EAlgorithm::BfsSequential, EAlgorithm::BfsParallel,
+          EAlgorithm::FloydSequential, EAlgorithm::FloydParallel}) {
+        assert(loaded.Predict(algorithm, stats, 4) ==
+               model.Predict(algorithm, stats, 4));
+    }
+
+    // A large sparse graph must never be sent to Floyd–Warshall.
+    TAutomaticShortestPathFinder automatic{model};
+    [[maybe_unused]] auto decision = automatic.Select(stats);
+    assert(decision.Algorithm != EAlgorithm::FloydSequential &&
+           decision.Algorithm != EAlgorithm::FloydParallel);
+
+    // Coefficients keep every digit through a save and a load.
+    std::stringstream precise(
+        "version 1\nhardware_threads 4\nbfs_seq_step_ns 1.2345678901234567\n"
+        "bfs_par_step_ns 20\nthread_spawn_ns 20000\n"
+        "floyd_relaxation_ns 1\n");
+    TCostModel calibrated;
+    calibrated.Load(precise);
+    std::stringstream resaved;
+    calibrated.Save(resaved);
+    loaded.Load(resaved);
+    assert(loaded.Predict(EAlgorithm::BfsSequential, stats, 1) ==
+           calibrated.Predict(EAlgorithm::BfsSequential, stats, 1));
+
+    // Unknown and repeated keys and out-of-range thread counts are rejected.
+    for (const char* malformed :
+         {"version 1\nbogus 1\n",
+          "version 1\nbfs_seq_step_ns 1\nbfs_seq_step_ns 1\n"
+          "bfs_seq_step_ns 1\nbfs_seq_step_ns 1\nbfs_seq_step_ns 1\n",
+          "version 1\nhardware_threads 1e300\nbfs_seq_step_ns 5\n"
+          "bfs_par_step_ns 20\nthread_spawn_ns 20000\n"
+          "floyd_relaxation_ns 1\n"}) {
+        std::istringstream in(malformed);
+        [[maybe_unused]] bool thrown = false;
+        try {
+            loaded.Load(in);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+}
+
+// Checks that the expected error is thrown when computing the query.
+template <typename TError>
+bool throwsError(auto&& func) {
+    try {
+        func();
+    } catch (const TError&) {
+        return true;
+    }
+    return false;
+}
+
+// Checks asynchronous execution, deadlines and cancellation.
+void testAsyncQueries() {
+    constexpr int n = 50;
+    std::istringstream iss(
+        NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n)));
+    TGraph graph;
+    graph.Load(iss);
+
+    TBreadthFirstSearch bfs;
+    TFloydWarshall floyd;
+    auto expected = bfs.Compute(graph, 0);
+
+    // A stopped token interrupts every finder.
+    std::stop_source stopped;
+    stopped.request_stop();
+    TCancellationToken cancelled(stopped.get_token());
+    assert(throwsError<TQueryCancelledError>(
+        [&] { (void)bfs.Compute(graph, 0, cancelled); }));
+    assert(throwsError<TQueryCancelledError>(
+        [&] { (void)floyd.Compute(graph, 0, cancelled); }));
+
+    TQueryExecutor executor(2);
+    // Queries in both lanes produce the same distances.
+    auto point = executor.Submit(bfs, graph, 0);
+    auto bulk = executor.Submit(floyd, graph, 0, {EQueryPriority::Bulk});
+    assert(point.Result().get() == expected);
+    assert(bulk.Result().get() == expected);
+
+    // An expired deadline fails the query before it runs.
+    auto expired = executor.Submit(
+        floyd, graph, 0,
+        {EQueryPriority::Bulk, TCancellationToken::TClock::now()});
+    assert(throwsError<TDeadlineExceededError>(
+        [&] { (void)expired.Result().get(); }));
+
+    // A query cancelled while queued or running fails with the cancel error,
+    // one that finished first keeps its result.
+    auto cancellable = executor.Submit(floyd, graph, 0, {EQueryPriority::Bulk});
+    cancellable.Cancel();
+    try {
+        assert(cancellable.Result().get() == expected);
+    } catch (const TQueryCancelledError&) {
+    }
+
+    // A single requested worker still leaves one free for point queries.
+    TQueryExecutor single(1);
+    assert(single.ThreadsCount() == 2);
+
+    // Shutdown interrupts a running all-pairs job instead of waiting for it.
+    constexpr int large = 600;
+    std::istringstream largeIss(NGraphFactory::SerializeGraph(
+        large, NGraphFactory::GenerateTree(large)));
+    TGraph largeGraph;
+    largeGraph.Load(largeIss);
+    TQueryHandle running = [&] {
+        TQueryExecutor shortLived(2);
+        auto handle =
+            shortLived.Submit(floyd, largeGraph, 0, {EQueryPriority::Bulk});
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return handle;
+    }();
+    assert(throwsError<TQueryCancelledError>(
+        [&] { (void)running.Result().get(); }));
+}
+
+// Checks the compact encoding, the cache hits, the eviction and the
+// invalidation on graph changes.
+void testResultCache() {
+    // Every width round-trips, including unreachable vertices.
+    for (int maxDistance : {3, 300, 70000}) {
+        std::vector<int> distances = {0, -1, maxDistance, 1};
+        TCompactDistances compact(distances);
+        assert(compact.Decode() == distances);
+    }
+    assert(TCompactDistances({0, 254}).Width() == 1);
+    assert(TCompactDistances({0, 255}).Width() == 2);
+    assert(TCompactDistances({0, 70000}).Width() == 4);
+
+    constexpr int n = 50;
+    auto serialized =
+        NGraphFactory::SerializeGraph(n, NGraphFactory::GenerateTree(n));
+    std::istringstream iss(serialized);
+    TGraph graph;
+    graph.Load(iss);
+
+    TBreadthFirstSearch bfs;
+    TResultCache cache(1 << 20, 4);
+    TCachedShortestPathFinder cached(bfs, "bfs-seq", cache);
+
+    // The second query for a source is a hit with identical distances.
+    auto expected = bfs.Compute(graph, 3);
+    assert(cached.Compute(graph, 3) == expected);
+    assert(cached.Compute(graph, 3) == expected);
+    auto stats = cache.Statistics();
+    assert(stats.Hits == 1 && stats.Misses == 1 && stats.Entries == 1);
+    assert(stats.Bytes > 0);
+
+    // Reloading the graph changes its version and drops the old results.
+    [[maybe_unused]] auto oldVersion = graph.Version();
+    std::istringstream reload(serialized);
+    graph.Load(reload);
+    assert(graph.Version() != oldVersion);
+    assert(graph.PreviousVersion() == oldVersion);
+    assert(cached.Compute(graph, 3) == expected);
+    stats = cache.Statistics();
+    assert(stats.Misses == 2 && stats.Entries == 1);
+
+    // Alternating between graphs still drops the stale results of each one.
+    std::istringstream otherIss(serialized);
+    TGraph other;
+    other.Load(otherIss);
+    assert(cached.Compute(other, 3) == expected);
+    std::istringstream reloadAgain(serialized);
+    graph.Load(reloadAgain);
+    assert(cached.Compute(other, 3) == expected);
+    assert(cached.Compute(graph, 3) == expected);
+    stats = cache.Statistics();
+    assert(stats.Entries == 2);
+
+    // A tiny budget keeps only the most recent results.
+    TResultCache tiny(2 * 1024, 1);
+    TCachedShortestPathFinder evicting(bfs, "bfs-seq", tiny);
+    for (int v = 0; v < n; ++v) {
+        assert(evicting.Compute(graph, v) == bfs.Compute(graph, v));
+    }
+    stats = tiny.Statistics();
+    assert(stats.Evictions > 0 && stats.Bytes <= 2 * 1024);
+}
+
+// Checks the partitioned BFS on a disconnected graph and its statistics.
+void testPartitionedBfs() {
+    // Two paths 0-1-...-19 and 20-21-...-39.
+    constexpr int n = 40;
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i + 1 < n; ++i) {
+        if (i != 19) {
+            edges.push_back({i, i + 1});
+        }
+    }
+    std::istringstream iss(NGraphFactory::SerializeGraph(n, edges));
+    TGraph graph;
+    graph.Load(iss);
+
+    TBreadthFirstSearch bfs;
+    for (int parts : {1, 2, 4, 7}) {
+        TPartitionedBreadthFirstSearch partitioned(parts);
+        for (int start : {0, 13, 39}) {
+            auto result = partitioned.ComputeWithStats(graph, start);
+            assert(result.Distances == bfs.Compute(graph, start));
+
+            // Every vertex of the component is expanded exactly once and a
+            // single partition sends nothing.
+            long long expanded = 0, messages = 0;
+            for (const auto& level : result.Levels) {
+                expanded += level.Frontier;
+                messages += level.Messages;
+            }
+            assert(expanded == n / 2);
+            assert(parts > 1 || messages == 0);
+        }
+    }
+
+    // A cancelled token stops the workers.
+    std::stop_source stopped;
+    stopped.request_stop();
+    TPartitionedBreadthFirstSearch partitioned(2);
+    assert(throwsError<TQueryCancelledError>([&] {
+        (void)partitioned.Compute(graph, 0,
+                                  TCancellationToken(stopped.get_token()));
+    }));
+}
+
+// Checks the predecessor trees of the BFS finders on a disconnected graph.
+void testShortestPathTrees() {
+    // A cycle 0-1-...-9 and a path 10-11-...-19.
+    constexpr int n = 20;
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 10; ++i) {
+        edges.push_back({i, (i + 1) % 10});
+    }
+    for (int i = 10; i + 1 < n; ++i) {
+        edges.push_back({i, i + 1});
+    }
+    std::istringstream iss(NGraphFactory::SerializeGraph(n, edges));
+    TGraph graph;
+    graph.Load(iss);
+
+    // Unreachable vertices have neither a distance nor a path.
+    TBreadthFirstSearch bfs;
+    TBreadthFirstSearchParallel parallel(4);
+    for (int start : {0, 13, 19}) {
+        auto distances = bfs.Compute(graph, start);
+        checkTree(graph, start, bfs.ComputeTree(graph, start), distances);
+        checkTree(graph, start, parallel.ComputeTree(graph, start), distances);
+    }
+
+    // Trees without a predecessor for every vertex or with a cycle in the
+    // predecessors are rejected instead of read out of bounds or forever.
+    assert(throwsError<std::invalid_argument>(
+        [] { (void)ExtractPath(TShortestPathTree{{0, 1}, {}}, 1); }));
+    assert(throwsError<std::invalid_argument>([] {
+        (void)ExtractPath(TShortestPathTree{{0, 1, 2}, {-1, 2, 1}}, 2);
+    }));
+    assert(throwsError<std::invalid_argument>(
+        [] { (void)ExtractPath(TShortestPathTree{{0, 2}, {-1, 0}}, 1); }));
 }
 
 int main() {
@@ -56,6 +430,13 @@ int main() {
         for (int n = 2; n <= 50; ++n) {
             runTest(n);
         }
+        testStatistics();
+        testDisconnectedStatistics();
+        testCostModelProfile();
+        testAsyncQueries();
+        testResultCache();
+        testPartitionedBfs();
+        testShortestPathTrees();
         // Print success message.
         std::print(stdout, "All tests passed.\n");
     } catch (const std::exception& e) {